@@ -4,6 +4,7 @@
 
 #include <bench/bench.h>
 
+#include <crypto/scrypt.h>
 #include <crypto/sha256.h>
 #include <util/strencodings.h>
 #include <util/system.h>
@@ -41,6 +42,7 @@ int main(int argc, char** argv)
     ArgsManager argsman;
     SetupBenchArgs(argsman);
     SHA256AutoDetect();
+    scrypt_detect_multi();
     std::string error;
     if (!argsman.ParseParameters(argc, argv, error)) {
         tfm::format(std::cerr, "Error parsing command line arguments: %s\n", error);
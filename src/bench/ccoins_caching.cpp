@@ -5,9 +5,11 @@
 #include <bench/bench.h>
 #include <coins.h>
 #include <policy/policy.h>
+#include <random.h>
 #include <script/signingprovider.h>
 #include <test/util/transaction_utils.h>
 
+#include <algorithm>
 #include <vector>
 
 // Microbenchmark for simple accesses to a CCoinsViewCache database. Note from
@@ -52,3 +54,99 @@ static void CCoinsCaching(benchmark::Bench& bench)
 }
 
 BENCHMARK(CCoinsCaching);
+
+namespace {
+/** Drops the flushed entries the same way CCoinsViewDB::BatchWrite walks them, without writing to disk. */
+class CCoinsViewSink : public CCoinsView
+{
+public:
+    bool BatchWrite(CCoinsMap& mapCoins, const uint256& hashBlock, const mw::CoinsViewCache::Ptr& derivedView) override
+    {
+        for (auto it = mapCoins.begin(); it != mapCoins.end(); it = mapCoins.erase(it)) {
+            if (it->second.flags & CCoinsCacheEntry::DIRTY) {
+                ++m_written;
+            }
+        }
+        return true;
+    }
+
+    size_t m_written{0};
+};
+
+/**
+ * Number of coins used by the cache throughput benchmarks below. Defaults to a
+ * size that runs quickly, pass e.g. -asymptote=1000000,10000000,30000000 to
+ * measure how the cache scales up to the sizes reached with a large -dbcache.
+ */
+size_t NumCoins(const benchmark::Bench& bench)
+{
+    return bench.complexityN() > 1 ? static_cast<size_t>(bench.complexityN()) : 100000;
+}
+
+std::vector<COutPoint> CreateOutpoints(size_t num_coins)
+{
+    FastRandomContext det_rand{true};
+    std::vector<COutPoint> outpoints;
+    outpoints.reserve(num_coins);
+    for (size_t i = 0; i < num_coins; ++i) {
+        outpoints.emplace_back(det_rand.rand256(), det_rand.randrange(4));
+    }
+    return outpoints;
+}
+
+void FillCache(CCoinsViewCache& cache, const std::vector<COutPoint>& outpoints)
+{
+    const CTxOut txout{COIN, CScript() << OP_TRUE};
+    for (const COutPoint& outpoint : outpoints) {
+        cache.AddCoin(outpoint, Coin{txout, 1, false, false}, false);
+    }
+}
+} // namespace
+
+static void CCoinsCachingInsert(benchmark::Bench& bench)
+{
+    const std::vector<COutPoint> outpoints = CreateOutpoints(NumCoins(bench));
+    CCoinsViewSink sink;
+
+    bench.batch(outpoints.size()).unit("coin").run([&] {
+        CCoinsViewCache cache(&sink);
+        FillCache(cache, outpoints);
+        assert(cache.GetCacheSize() == outpoints.size());
+    });
+}
+
+static void CCoinsCachingLookup(benchmark::Bench& bench)
+{
+    std::vector<COutPoint> outpoints = CreateOutpoints(NumCoins(bench));
+    CCoinsViewSink sink;
+    CCoinsViewCache cache(&sink);
+    FillCache(cache, outpoints);
+
+    // Look the coins up in a different order than they were inserted in, as blocks spend them.
+    Shuffle(outpoints.begin(), outpoints.end(), FastRandomContext{true});
+    bench.batch(outpoints.size()).unit("coin").run([&] {
+        for (const COutPoint& outpoint : outpoints) {
+            const Coin& coin = cache.AccessCoin(outpoint);
+            assert(!coin.IsSpent());
+        }
+    });
+}
+
+static void CCoinsCachingFlush(benchmark::Bench& bench)
+{
+    const std::vector<COutPoint> outpoints = CreateOutpoints(NumCoins(bench));
+    CCoinsViewSink sink;
+
+    // Includes filling the cache, since each flush empties it.
+    bench.batch(outpoints.size()).unit("coin").run([&] {
+        CCoinsViewCache cache(&sink);
+        FillCache(cache, outpoints);
+        bool success = cache.Flush();
+        assert(success);
+    });
+    assert(sink.m_written > 0);
+}
+
+BENCHMARK(CCoinsCachingInsert);
+BENCHMARK(CCoinsCachingLookup);
+BENCHMARK(CCoinsCachingFlush);
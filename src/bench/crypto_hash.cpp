@@ -5,6 +5,7 @@
 
 #include <bench/bench.h>
 #include <crypto/ripemd160.h>
+#include <crypto/scrypt.h>
 #include <crypto/sha1.h>
 #include <crypto/sha256.h>
 #include <crypto/sha3.h>
@@ -71,6 +72,35 @@ static void SHA256D64_1024(benchmark::Bench& bench)
     });
 }
 
+/* Number of block headers to hash per iteration of the multi-lane scrypt benchmark */
+static const size_t SCRYPT_BATCH_SIZE = 64;
+
+static void Scrypt(benchmark::Bench& bench)
+{
+    uint8_t hash[32];
+    std::vector<char> in(80, 0);
+    bench.unit("hash").run([&] {
+        scrypt_1024_1_1_256(in.data(), (char*)hash);
+        ++in[76];
+    });
+}
+
+static void ScryptMulti(benchmark::Bench& bench)
+{
+    std::vector<char> in(80 * SCRYPT_BATCH_SIZE, 0);
+    std::vector<char> out(32 * SCRYPT_BATCH_SIZE);
+    std::vector<const char*> inputs;
+    std::vector<char*> outputs;
+    for (size_t i = 0; i < SCRYPT_BATCH_SIZE; ++i) {
+        in[80 * i + 76] = (char)i;
+        inputs.push_back(&in[80 * i]);
+        outputs.push_back(&out[32 * i]);
+    }
+    bench.batch(SCRYPT_BATCH_SIZE).unit("hash").run([&] {
+        scrypt_1024_1_1_256_multi(inputs.data(), outputs.data(), SCRYPT_BATCH_SIZE);
+    });
+}
+
 static void SHA512(benchmark::Bench& bench)
 {
     uint8_t hash[CSHA512::OUTPUT_SIZE];
@@ -114,5 +144,7 @@ BENCHMARK(SHA3_256_1M);
 BENCHMARK(SHA256_32b);
 BENCHMARK(SipHash_32b);
 BENCHMARK(SHA256D64_1024);
+BENCHMARK(Scrypt);
+BENCHMARK(ScryptMulti);
 BENCHMARK(FastRandom_32bit);
 BENCHMARK(FastRandom_1bit);
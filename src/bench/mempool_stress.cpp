@@ -3,6 +3,7 @@
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
 #include <bench/bench.h>
+#include <mw/models/tx/Transaction.h>
 #include <policy/policy.h>
 #include <test/util/setup_common.h>
 #include <txmempool.h>
@@ -92,3 +93,76 @@ static void ComplexMemPool(benchmark::Bench& bench)
 }
 
 BENCHMARK(ComplexMemPool);
+
+/**
+ * Builds an MWEB-only transaction spending the given output IDs.
+ * Commitments are random bytes rather than real Pedersen commitments, since addUnchecked
+ * and TrimToSize only index the inputs, outputs, and kernels by their IDs.
+ */
+static CTransactionRef MakeMWEBTx(FastRandomContext& rand, const std::vector<mw::Hash>& spent_ids, const size_t num_outputs)
+{
+    std::vector<Input> inputs;
+    for (const mw::Hash& output_id : spent_ids) {
+        inputs.push_back(Input(0, output_id, Commitment(BigInt<33>(rand.randbytes(33))), PublicKey(), PublicKey(), Signature()));
+    }
+
+    std::vector<Output> outputs;
+    for (size_t i = 0; i < num_outputs; ++i) {
+        outputs.push_back(Output(Commitment(BigInt<33>(rand.randbytes(33))), PublicKey(), PublicKey(), OutputMessage(), std::make_shared<const RangeProof>(), Signature()));
+    }
+
+    std::vector<Kernel> kernels{
+        Kernel(0, boost::none, boost::none, {}, boost::none, boost::none, {}, Commitment(BigInt<33>(rand.randbytes(33))), Signature())
+    };
+
+    CMutableTransaction tx;
+    tx.mweb_tx = MWEB::Tx(std::make_shared<const mw::Transaction>(BlindingFactor(), BlindingFactor(), TxBody(inputs, outputs, kernels)));
+    return MakeTransactionRef(tx);
+}
+
+/**
+ * Same shape as ComplexMemPool, but every transaction spends and creates MWEB outputs,
+ * so the pool's conflict and output lookups all go through the MWEB indexes.
+ */
+static void MWEBMemPool(benchmark::Bench& bench)
+{
+    int childTxs = 800;
+    if (bench.complexityN() > 1) {
+        childTxs = static_cast<int>(bench.complexityN());
+    }
+
+    FastRandomContext det_rand{true};
+    std::vector<mw::Hash> available_outputs;
+    std::vector<CTransactionRef> ordered_txs;
+    // Create some base transactions spending confirmed outputs
+    for (auto x = 0; x < 100; ++x) {
+        ordered_txs.push_back(MakeMWEBTx(det_rand, { mw::Hash(det_rand.randbytes(32)) }, det_rand.randrange(10) + 2));
+        const auto& output_ids = ordered_txs.back()->mweb_tx.GetOutputIDs();
+        available_outputs.insert(available_outputs.end(), output_ids.begin(), output_ids.end());
+    }
+    for (auto x = 0; x < childTxs && !available_outputs.empty(); ++x) {
+        std::vector<mw::Hash> spent_ids;
+        size_t n_inputs = det_rand.randrange(10) + 1;
+        for (size_t i = 0; i < n_inputs && !available_outputs.empty(); ++i) {
+            size_t idx = det_rand.randrange(available_outputs.size());
+            spent_ids.push_back(available_outputs[idx]);
+            available_outputs[idx] = available_outputs.back();
+            available_outputs.pop_back();
+        }
+        ordered_txs.push_back(MakeMWEBTx(det_rand, spent_ids, det_rand.randrange(10) + 2));
+        const auto& output_ids = ordered_txs.back()->mweb_tx.GetOutputIDs();
+        available_outputs.insert(available_outputs.end(), output_ids.begin(), output_ids.end());
+    }
+    TestingSetup test_setup;
+    CTxMemPool pool;
+    LOCK2(cs_main, pool.cs);
+    bench.run([&]() NO_THREAD_SAFETY_ANALYSIS {
+        for (auto& tx : ordered_txs) {
+            AddTx(tx, pool);
+        }
+        pool.TrimToSize(pool.DynamicMemoryUsage() * 3 / 4);
+        pool.TrimToSize(GetVirtualTransactionSize(*ordered_txs.front()));
+    });
+}
+
+BENCHMARK(MWEBMemPool);
@@ -0,0 +1,52 @@
+// Copyright (c) 2021 The Litecoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <bench/bench.h>
+
+#include <mw/crypto/Hasher.h>
+#include <random.h>
+
+#include <cassert>
+
+// Message sizes typical of MWEB hashing:
+//  72 bytes: an MMR parent node (position, left hash, right hash)
+// 256 bytes: a serialized kernel
+// 4 KiB: a serialized output including its rangeproof, which spans multiple BLAKE3 chunks
+static void HashMWEB(benchmark::Bench& bench, const size_t len)
+{
+    FastRandomContext rng(true);
+    const std::vector<uint8_t> in = rng.randbytes(len);
+    bench.batch(in.size()).unit("byte").run([&] {
+        mw::Hash hash = Hashed(in);
+        assert(!hash.IsZero());
+    });
+}
+
+static void MWEBHash_72(benchmark::Bench& bench) { HashMWEB(bench, 72); }
+static void MWEBHash_256(benchmark::Bench& bench) { HashMWEB(bench, 256); }
+static void MWEBHash_4096(benchmark::Bench& bench) { HashMWEB(bench, 4096); }
+
+// Hashes a whole height of 4096 MMR parent nodes at once, as MMRUtil::CalcAppendedHashes does.
+static void MWEBHashMany_72(benchmark::Bench& bench)
+{
+    const size_t num_messages = 4096;
+    const size_t len = 72;
+
+    FastRandomContext rng(true);
+    const std::vector<uint8_t> messages = rng.randbytes(num_messages * len);
+    std::vector<const uint8_t*> inputs;
+    for (size_t i = 0; i < num_messages; i++) {
+        inputs.push_back(messages.data() + (i * len));
+    }
+
+    bench.batch(messages.size()).unit("byte").run([&] {
+        std::vector<mw::Hash> hashes = HashedMany(inputs, len);
+        assert(hashes.size() == num_messages);
+    });
+}
+
+BENCHMARK(MWEBHash_72);
+BENCHMARK(MWEBHash_256);
+BENCHMARK(MWEBHash_4096);
+BENCHMARK(MWEBHashMany_72);
@@ -0,0 +1,116 @@
+// Copyright (c) 2021 The Litecoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <bench/bench.h>
+
+#include <mw/mmr/MMR.h>
+#include <mw/mmr/MMRUtil.h>
+#include <mw/mmr/PruneList.h>
+#include <mweb/mweb_db.h>
+#include <random.h>
+#include <test/util/setup_common.h>
+#include <util/system.h>
+
+static void PruneListGetShift(benchmark::Bench& bench)
+{
+    const BasicTestingSetup testing_setup{};
+
+    // Compact an MMR with 4 million leaves, of which roughly 1 in 16 are still unspent.
+    const uint64_t num_leaves = 4'000'000;
+    FastRandomContext rng(true);
+    BitSet unspent(num_leaves);
+    for (uint64_t i = 0; i < num_leaves; i++) {
+        if (rng.randrange(16) == 0) {
+            unspent.set(i);
+        }
+    }
+
+    BitSet compacted = MMRUtil::BuildCompactBitSet(num_leaves, unspent);
+    PruneList::Ptr pPruneList = PruneList::Open(GetDataDir(), 0);
+    pPruneList->Commit(1, compacted);
+
+    std::vector<mmr::Index> unpruned;
+    while (unpruned.size() < 1000) {
+        mmr::Index idx = mmr::Index::At(rng.randrange(compacted.size()));
+        if (!compacted.test(idx.GetPosition())) {
+            unpruned.push_back(idx);
+        }
+    }
+
+    size_t i = 0;
+    uint64_t total = 0;
+    bench.run([&] {
+        total += pPruneList->GetShift(unpruned[i++ % unpruned.size()]);
+    });
+    assert(total > 0);
+}
+
+BENCHMARK(PruneListGetShift);
+
+// Builds a file-backed MMR with 100,000 committed leaves.
+static PMMR::Ptr BuildPMMR(const mw::DBWrapper::Ptr& pDB)
+{
+    PMMR::Ptr pPMMR = PMMR::Open('O', GetDataDir() / "mmr", 0, pDB, nullptr);
+    PMMRCache cache(pPMMR);
+    for (uint32_t i = 0; i < 100'000; i++) {
+        cache.Add(std::vector<uint8_t>{ uint8_t(i), uint8_t(i >> 8), uint8_t(i >> 16) });
+    }
+
+    cache.Flush(1, nullptr);
+    return pPMMR;
+}
+
+static void PMMRGetHash(benchmark::Bench& bench)
+{
+    const BasicTestingSetup testing_setup{};
+    CDBWrapper db(GetDataDir() / "db", 1 << 15);
+    PMMR::Ptr pPMMR = BuildPMMR(std::make_shared<MWEB::DBWrapper>(&db));
+
+    FastRandomContext rng(true);
+    std::vector<mmr::Index> indices;
+    for (size_t i = 0; i < 1000; i++) {
+        indices.push_back(mmr::Index::At(rng.randrange(pPMMR->GetNumNodes())));
+    }
+
+    size_t i = 0;
+    uint8_t total = 0;
+    bench.run([&] {
+        total ^= pPMMR->GetHash(indices[i++ % indices.size()])[0];
+    });
+}
+
+static void PMMRGetHashView(benchmark::Bench& bench)
+{
+    const BasicTestingSetup testing_setup{};
+    CDBWrapper db(GetDataDir() / "db", 1 << 15);
+    PMMR::Ptr pPMMR = BuildPMMR(std::make_shared<MWEB::DBWrapper>(&db));
+
+    FastRandomContext rng(true);
+    std::vector<mmr::Index> indices;
+    for (size_t i = 0; i < 1000; i++) {
+        indices.push_back(mmr::Index::At(rng.randrange(pPMMR->GetNumNodes())));
+    }
+
+    size_t i = 0;
+    uint8_t total = 0;
+    bench.run([&] {
+        total ^= pPMMR->GetHashView(indices[i++ % indices.size()]).data()[0];
+    });
+}
+
+static void PMMRRoot(benchmark::Bench& bench)
+{
+    const BasicTestingSetup testing_setup{};
+    CDBWrapper db(GetDataDir() / "db", 1 << 15);
+    PMMR::Ptr pPMMR = BuildPMMR(std::make_shared<MWEB::DBWrapper>(&db));
+
+    bench.run([&] {
+        mw::Hash root = pPMMR->Root();
+        assert(!root.IsZero());
+    });
+}
+
+BENCHMARK(PMMRGetHash);
+BENCHMARK(PMMRGetHashView);
+BENCHMARK(PMMRRoot);
@@ -7,6 +7,7 @@
 #include <consensus/consensus.h>
 #include <logging.h>
 #include <random.h>
+#include <util/memory.h>
 #include <version.h>
 
 bool CCoinsView::GetCoin(const COutPoint &outpoint, Coin &coin) const { return false; }
@@ -36,11 +37,11 @@ bool CCoinsViewBacked::BatchWrite(CCoinsMap& mapCoins, const uint256& hashBlock,
 CCoinsViewCursor *CCoinsViewBacked::Cursor() const { return base->Cursor(); }
 size_t CCoinsViewBacked::EstimateSize() const { return base->EstimateSize(); }
 mw::ICoinsView::Ptr CCoinsViewBacked::GetMWEBView() const { return base->GetMWEBView(); }
-bool CCoinsViewBacked::GetMWEBCoin(const mw::Hash& output_id, Output& coin) const { return base->GetMWEBCoin(output_id, coin); }
+bool CCoinsViewBacked::GetMWEBCoin(const mw::Hash& output_id, UTXO::CPtr& coin) const { return base->GetMWEBCoin(output_id, coin); }
 
 SaltedOutpointHasher::SaltedOutpointHasher() : k0(GetRand(std::numeric_limits<uint64_t>::max())), k1(GetRand(std::numeric_limits<uint64_t>::max())) {}
 
-CCoinsViewCache::CCoinsViewCache(CCoinsView* baseIn) : CCoinsViewBacked(baseIn), cachedCoinsUsage(0), mweb_view(baseIn->GetMWEBView() ? std::make_shared<mw::CoinsViewCache>(baseIn->GetMWEBView()) : nullptr) {}
+CCoinsViewCache::CCoinsViewCache(CCoinsView* baseIn) : CCoinsViewBacked(baseIn), m_cache_coins_memory_resource{MakeUnique<CCoinsMapMemoryResource>()}, cacheCoins{0, SaltedOutpointHasher{}, CCoinsMap::key_equal{}, m_cache_coins_memory_resource.get()}, cachedCoinsUsage(0), mweb_view(baseIn->GetMWEBView() ? std::make_shared<mw::CoinsViewCache>(baseIn->GetMWEBView()) : nullptr) {}
 
 size_t CCoinsViewCache::DynamicMemoryUsage() const {
     return memusage::DynamicUsage(cacheCoins) + cachedCoinsUsage;
@@ -106,6 +107,16 @@ void CCoinsViewCache::AddCoin(const COutPoint &outpoint, Coin&& coin, bool possi
     cachedCoinsUsage += it->second.coin.DynamicMemoryUsage();
 }
 
+bool CCoinsViewCache::WarmCoin(const COutPoint& outpoint, Coin&& coin) {
+    assert(!coin.IsSpent());
+    std::pair<CCoinsMap::iterator, bool> inserted = cacheCoins.emplace(std::piecewise_construct, std::forward_as_tuple(outpoint), std::forward_as_tuple(std::move(coin)));
+    if (inserted.second) {
+        // Not DIRTY, since the base view has the same version of the coin.
+        cachedCoinsUsage += inserted.first->second.coin.DynamicMemoryUsage();
+    }
+    return inserted.second;
+}
+
 void AddCoins(CCoinsViewCache& cache, const CTransaction &tx, int nHeight, bool check_for_overwrite) {
     bool fCoinbase = tx.IsCoinBase();
     const uint256& txid = tx.GetHash();
@@ -165,11 +176,10 @@ bool CCoinsViewCache::HaveCoin(const OutputIndex& index) const {
     }
 }
 
-bool CCoinsViewCache::GetMWEBCoin(const mw::Hash& output_id, Output& coin) const {
+bool CCoinsViewCache::GetMWEBCoin(const mw::Hash& output_id, UTXO::CPtr& coin) const {
     if (GetMWEBCacheView()->HasCoinInCache(output_id)) {
-        UTXO::CPtr utxo = GetMWEBCacheView()->GetUTXO(output_id);
-        assert(utxo != nullptr);
-        coin = utxo->GetOutput();
+        coin = GetMWEBCacheView()->GetUTXO(output_id);
+        assert(coin != nullptr);
         return true;
     }
 
@@ -268,10 +278,22 @@ bool CCoinsViewCache::BatchWrite(CCoinsMap &mapCoins, const uint256 &hashBlockIn
 bool CCoinsViewCache::Flush() {
     bool fOk = base->BatchWrite(cacheCoins, hashBlock, mweb_view);
     cacheCoins.clear();
+    // Release the pooled memory, or else DynamicMemoryUsage() would keep reporting the old peak.
+    ReallocateCache();
     cachedCoinsUsage = 0;
     return fOk;
 }
 
+CCoinsMapSnapshot CCoinsViewCache::DetachEntries()
+{
+    const size_t usage = DynamicMemoryUsage();
+    CCoinsMapSnapshot snapshot{std::move(m_cache_coins_memory_resource), std::move(cacheCoins), hashBlock, usage};
+    cacheCoins.clear();
+    ReallocateCache();
+    cachedCoinsUsage = 0;
+    return snapshot;
+}
+
 void CCoinsViewCache::Uncache(const OutputIndex& coin)
 {
     if (coin.type() == typeid(COutPoint)) {
@@ -304,7 +326,8 @@ void CCoinsViewCache::ReallocateCache()
     // Cache should be empty when we're calling this.
     assert(cacheCoins.size() == 0);
     cacheCoins.~CCoinsMap();
-    ::new (&cacheCoins) CCoinsMap();
+    m_cache_coins_memory_resource = MakeUnique<CCoinsMapMemoryResource>();
+    ::new (&cacheCoins) CCoinsMap{0, SaltedOutpointHasher{}, CCoinsMap::key_equal{}, m_cache_coins_memory_resource.get()};
 }
 
 static const size_t MIN_TRANSACTION_OUTPUT_WEIGHT = WITNESS_SCALE_FACTOR * ::GetSerializeSize(CTxOut(), PROTOCOL_VERSION);
@@ -13,12 +13,14 @@
 #include <mw/node/CoinsView.h>
 #include <primitives/transaction.h>
 #include <serialize.h>
+#include <support/allocators/pool.h>
 #include <uint256.h>
 
 #include <assert.h>
 #include <stdint.h>
 
 #include <functional>
+#include <memory>
 #include <unordered_map>
 
 /**
@@ -164,7 +166,37 @@ struct CCoinsCacheEntry
     explicit CCoinsCacheEntry(Coin&& coin_) : coin(std::move(coin_)), flags(0) {}
 };
 
-typedef std::unordered_map<COutPoint, CCoinsCacheEntry, SaltedOutpointHasher> CCoinsMap;
+/**
+ * PoolAllocator's MAX_BLOCK_SIZE_BYTES parameter here uses sizeof the data, and adds the size
+ * of 4 pointers. We do not know the exact node size used in the std::unordered_node implementation
+ * because it is implementation defined. Most implementations have an overhead of 1 or 2 pointers,
+ * so nodes can be connected in a linked list, and in some cases the hash value is stored as well.
+ * Using an additional sizeof(void*)*4 for MAX_BLOCK_SIZE_BYTES should thus be sufficient so that
+ * all implementations can allocate the nodes from the PoolAllocator.
+ */
+using CCoinsMap = std::unordered_map<COutPoint,
+                                     CCoinsCacheEntry,
+                                     SaltedOutpointHasher,
+                                     std::equal_to<COutPoint>,
+                                     PoolAllocator<std::pair<const COutPoint, CCoinsCacheEntry>,
+                                                   sizeof(std::pair<const COutPoint, CCoinsCacheEntry>) + sizeof(void*) * 4,
+                                                   alignof(void*)>>;
+
+using CCoinsMapMemoryResource = CCoinsMap::allocator_type::ResourceType;
+
+/**
+ * Entries moved out of a CCoinsViewCache, together with the memory resource
+ * they were allocated from.
+ */
+struct CCoinsMapSnapshot
+{
+    std::unique_ptr<CCoinsMapMemoryResource> resource;
+    CCoinsMap map;
+    //! Block the entries are consistent with.
+    uint256 hashBlock;
+    //! Memory usage of the entries, as reported by CCoinsViewCache::DynamicMemoryUsage().
+    size_t usage;
+};
 
 /** Cursor for iterating over CoinsView state */
 class CCoinsViewCursor
@@ -223,7 +255,8 @@ public:
 
     virtual mw::ICoinsView::Ptr GetMWEBView() const { return nullptr; }
     
-    virtual bool GetMWEBCoin(const mw::Hash& output_id, Output& coin) const { return false; }
+    //! Retrieve the MWEB UTXO with the given output ID. Coins from the database don't carry their rangeproof.
+    virtual bool GetMWEBCoin(const mw::Hash& output_id, UTXO::CPtr& coin) const { return false; }
 };
 
 
@@ -244,7 +277,7 @@ public:
     CCoinsViewCursor *Cursor() const override;
     size_t EstimateSize() const override;
     mw::ICoinsView::Ptr GetMWEBView() const override;
-    bool GetMWEBCoin(const mw::Hash& output_id, Output& coin) const override;
+    bool GetMWEBCoin(const mw::Hash& output_id, UTXO::CPtr& coin) const override;
 };
 
 
@@ -257,6 +290,7 @@ protected:
      * declared as "const".
      */
     mutable uint256 hashBlock;
+    std::unique_ptr<CCoinsMapMemoryResource> m_cache_coins_memory_resource;
     mutable CCoinsMap cacheCoins;
 
     /* Cached dynamic memory usage for the inner Coin objects. */
@@ -286,7 +320,7 @@ public:
     mw::ICoinsView::Ptr GetMWEBView() const final { return mweb_view; }
     mw::CoinsViewCache::Ptr GetMWEBCacheView() const { return mweb_view; }
 
-    bool GetMWEBCoin(const mw::Hash& output_id, Output& coin) const final;
+    bool GetMWEBCoin(const mw::Hash& output_id, UTXO::CPtr& coin) const final;
 
     /**
      * Check if we have the given utxo already loaded in this cache.
@@ -313,6 +347,14 @@ public:
      */
     void AddCoin(const COutPoint& outpoint, Coin&& coin, bool possible_overwrite);
 
+    /**
+     * Add an unspent coin that was read from the base view elsewhere, such as
+     * by a prefetcher, unless the cache already has an entry for the outpoint.
+     * The coin must match the base view's current version of it. Returns
+     * whether it was added.
+     */
+    bool WarmCoin(const COutPoint& outpoint, Coin&& coin);
+
     /**
      * Spend a coin. Pass moveto in order to get the deleted data.
      * If no unspent output exists for the passed outpoint, this call
@@ -327,6 +369,13 @@ public:
      */
     bool Flush();
 
+    /**
+     * Moves all entries out of the cache, leaving it empty, without pushing
+     * them to its base. The best block is kept. Used to write the entries to
+     * the base while the cache keeps being used.
+     */
+    CCoinsMapSnapshot DetachEntries();
+
     /**
      * Removes the UTXO with the given outpoint from the cache, if it is
      * not modified.
@@ -0,0 +1,14 @@
+// Copyright (c) 2021 The Litecoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+// The bundled BLAKE3 AVX-512 kernel, used by libmw's Hasher when blake3_dispatch detects CPU support.
+// Besides AVX512F, the kernel uses AVX512VL rotates on 128/256-bit vectors, which is why AVX512_CXXFLAGS enables both.
+
+#ifdef ENABLE_AVX512
+
+extern "C" {
+#include <crypto/blake3/blake3_avx512.c>
+}
+
+#endif
@@ -0,0 +1,18 @@
+// Copyright (c) 2021 The Litecoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+// The bundled BLAKE3 SSE2 kernel, used by libmw's Hasher when blake3_dispatch detects CPU support.
+// SSE2 is part of the x86_64 baseline, so unlike the other kernels this needs no extra compiler flags.
+
+#if defined(HAVE_CONFIG_H)
+#include <config/bitcoin-config.h>
+#endif
+
+#if defined(USE_ASM) && !defined(BUILD_BITCOIN_INTERNAL) && (defined(__x86_64__) || defined(_M_X64))
+
+extern "C" {
+#include <crypto/blake3/blake3_sse2.c>
+}
+
+#endif
@@ -0,0 +1,13 @@
+// Copyright (c) 2021 The Litecoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+// The bundled BLAKE3 SSE4.1 kernel, used by libmw's Hasher when blake3_dispatch detects CPU support.
+
+#ifdef ENABLE_SSE41
+
+extern "C" {
+#include <crypto/blake3/blake3_sse41.c>
+}
+
+#endif
@@ -27,6 +27,10 @@
  * online backup system.
  */
 
+#if defined(HAVE_CONFIG_H)
+#include <config/bitcoin-config.h>
+#endif
+
 #include <crypto/scrypt.h>
 
 #include <stdlib.h>
@@ -34,6 +38,10 @@
 #include <string.h>
 #include <openssl/sha.h>
 
+#include <compat/cpuid.h>
+
+#include <memory>
+
 #if defined(USE_SSE2) && !defined(USE_SSE2_ALWAYS)
 #ifdef _MSC_VER
 // MSVC 64bit is unable to use inline asm
@@ -326,6 +334,155 @@ std::string scrypt_detect_sse2()
 }
 #endif
 
+namespace scrypt_avx2
+{
+void ScryptCore_8way(uint32_t* X, uint32_t* V);
+}
+
+namespace scrypt_avx512
+{
+void ScryptCore_16way(uint32_t* X, uint32_t* V);
+}
+
+namespace {
+
+/* The largest number of lanes of any multi-lane kernel. */
+const size_t SCRYPT_MAX_LANES = 16;
+
+typedef void (*ScryptCoreMulti)(uint32_t* X, uint32_t* V);
+
+struct ScryptMultiKernel {
+	size_t lanes;
+	ScryptCoreMulti core;
+};
+
+/* The detected multi-lane kernels, widest first. Empty until scrypt_detect_multi() is called. */
+ScryptMultiKernel scrypt_multi_kernels[2];
+size_t scrypt_multi_num_kernels = 0;
+
+void scrypt_1024_1_1_256_lanes(const char *inputs[], char *outputs[], const ScryptMultiKernel& kernel, uint32_t *V)
+{
+	uint8_t B[128];
+	uint32_t X[32 * SCRYPT_MAX_LANES];
+	const size_t lanes = kernel.lanes;
+	size_t l, k;
+
+	for (l = 0; l < lanes; l++) {
+		PBKDF2_SHA256((const uint8_t *)inputs[l], 80, (const uint8_t *)inputs[l], 80, 1, B, 128);
+		for (k = 0; k < 32; k++)
+			X[k * lanes + l] = le32dec(&B[4 * k]);
+	}
+
+	kernel.core(X, V);
+
+	for (l = 0; l < lanes; l++) {
+		for (k = 0; k < 32; k++)
+			le32enc(&B[4 * k], X[k * lanes + l]);
+		PBKDF2_SHA256((const uint8_t *)inputs[l], 80, B, 128, 1, (uint8_t *)outputs[l], 32);
+	}
+}
+
+#if defined(USE_ASM) && defined(HAVE_GETCPUID) && !defined(BUILD_BITCOIN_INTERNAL)
+/* Returns the XCR0 register, which says which register states the OS saves. */
+uint32_t GetXCR0()
+{
+	uint32_t a, d;
+	__asm__("xgetbv" : "=a"(a), "=d"(d) : "c"(0));
+	return a;
+}
+#endif
+
+} // namespace
+
+std::string scrypt_detect_multi()
+{
+	std::string ret = "scrypt: multi-lane kernels unavailable";
+	scrypt_multi_num_kernels = 0;
+#if defined(USE_ASM) && defined(HAVE_GETCPUID) && !defined(BUILD_BITCOIN_INTERNAL)
+	uint32_t eax, ebx, ecx, edx;
+	bool have_avx2 = false;
+	bool have_avx512 = false;
+	bool enabled_avx = false;
+	bool enabled_avx512 = false;
+
+	(void)have_avx2;
+	(void)have_avx512;
+	(void)enabled_avx;
+	(void)enabled_avx512;
+
+	GetCPUID(1, 0, eax, ebx, ecx, edx);
+	if (((ecx >> 27) & 1) && ((ecx >> 28) & 1)) {
+		const uint32_t xcr0 = GetXCR0();
+		enabled_avx = (xcr0 & 0x06) == 0x06;
+		enabled_avx512 = (xcr0 & 0xe6) == 0xe6;
+	}
+	GetCPUID(0, 0, eax, ebx, ecx, edx);
+	if (eax >= 7) {
+		GetCPUID(7, 0, eax, ebx, ecx, edx);
+		have_avx2 = (ebx >> 5) & 1;
+		have_avx512 = ((ebx >> 16) & 1) && ((ebx >> 31) & 1); // AVX512F and AVX512VL, matching AVX512_CXXFLAGS
+	}
+
+	ret = "scrypt: using";
+#if defined(ENABLE_AVX512)
+	if (have_avx512 && enabled_avx512) {
+		scrypt_multi_kernels[scrypt_multi_num_kernels++] = {16, scrypt_avx512::ScryptCore_16way};
+		ret += " avx512(16way)";
+	}
+#endif
+#if defined(ENABLE_AVX2)
+	if (have_avx2 && enabled_avx) {
+		scrypt_multi_kernels[scrypt_multi_num_kernels++] = {8, scrypt_avx2::ScryptCore_8way};
+		ret += " avx2(8way)";
+	}
+#endif
+	if (scrypt_multi_num_kernels == 0) {
+		ret = "scrypt: multi-lane kernels unavailable";
+	}
+#endif
+	return ret;
+}
+
+size_t scrypt_multi_lanes()
+{
+	return scrypt_multi_num_kernels > 0 ? scrypt_multi_kernels[0].lanes : 1;
+}
+
+/* One V per lane, interleaved, aligned for the widest kernel's stores.
+ * Each thread keeps its scratchpad, so batches don't allocate it on every call. */
+static uint32_t *scrypt_multi_scratchpad(size_t lanes)
+{
+	static thread_local std::unique_ptr<char[]> scratchpad;
+	static thread_local size_t scratchpad_lanes = 0;
+
+	if (scratchpad_lanes < lanes) {
+		scratchpad.reset(new char[1024 * 32 * sizeof(uint32_t) * lanes + 63]);
+		scratchpad_lanes = lanes;
+	}
+	return (uint32_t *)(((uintptr_t)(scratchpad.get()) + 63) & ~ (uintptr_t)(63));
+}
+
+void scrypt_1024_1_1_256_multi(const char *inputs[], char *outputs[], size_t n)
+{
+	size_t i = 0, k;
+
+	if (scrypt_multi_num_kernels > 0 && n >= scrypt_multi_kernels[scrypt_multi_num_kernels - 1].lanes) {
+		uint32_t *V = scrypt_multi_scratchpad(scrypt_multi_kernels[0].lanes);
+
+		for (k = 0; k < scrypt_multi_num_kernels; k++) {
+			const ScryptMultiKernel& kernel = scrypt_multi_kernels[k];
+			for (; n - i >= kernel.lanes; i += kernel.lanes)
+				scrypt_1024_1_1_256_lanes(&inputs[i], &outputs[i], kernel, V);
+		}
+	}
+
+	if (i < n) {
+		char scratchpad[SCRYPT_SCRATCHPAD_SIZE];
+		for (; i < n; i++)
+			scrypt_1024_1_1_256_sp(inputs[i], outputs[i], scratchpad);
+	}
+}
+
 void scrypt_1024_1_1_256(const char *input, char *output)
 {
 	char scratchpad[SCRYPT_SCRATCHPAD_SIZE];
@@ -3,14 +3,27 @@
 
 #include <stdlib.h>
 #include <stdint.h>
+#include <string>
 
 static const int SCRYPT_SCRATCHPAD_SIZE = 131072 + 63;
 
 void scrypt_1024_1_1_256(const char *input, char *output);
 void scrypt_1024_1_1_256_sp_generic(const char *input, char *output, char *scratchpad);
 
+/**
+ * Hashes n independent 80-byte inputs, writing each 32-byte hash to the matching output.
+ * Uses the widest interleaved kernel selected by scrypt_detect_multi(), and falls back to
+ * hashing one input at a time when no kernel is available or too few inputs remain.
+ */
+void scrypt_1024_1_1_256_multi(const char *inputs[], char *outputs[], size_t n);
+
+/** Autodetect the best available multi-lane scrypt kernel. Returns the name of the kernels in use. */
+std::string scrypt_detect_multi();
+
+/** The number of inputs the widest detected kernel hashes at once, or 1 if there is none. */
+size_t scrypt_multi_lanes();
+
 #if defined(USE_SSE2)
-#include <string>
 #if defined(_M_X64) || defined(__x86_64__) || defined(_M_AMD64) || (defined(MAC_OSX) && defined(__i386__))
 #define USE_SSE2_ALWAYS 1
 #define scrypt_1024_1_1_256_sp(input, output, scratchpad) scrypt_1024_1_1_256_sp_sse2((input), (output), (scratchpad))
@@ -0,0 +1,103 @@
+// Copyright (c) 2021 The Litecoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+// An 8-way scrypt core for x86_64 using AVX2 intrinsics, with one scrypt state per 32-bit lane.
+
+#ifdef ENABLE_AVX2
+
+#include <stdint.h>
+#include <immintrin.h>
+
+namespace scrypt_avx2 {
+namespace {
+
+__m256i inline Add(__m256i x, __m256i y) { return _mm256_add_epi32(x, y); }
+__m256i inline Xor(__m256i x, __m256i y) { return _mm256_xor_si256(x, y); }
+__m256i inline Rotl(__m256i x, int n) { return _mm256_or_si256(_mm256_slli_epi32(x, n), _mm256_srli_epi32(x, 32 - n)); }
+
+/** Salsa20/8 of B ^ Bx, added to B, in each of the 8 lanes. */
+void inline __attribute__((always_inline)) XorSalsa8(__m256i B[16], const __m256i Bx[16])
+{
+    __m256i x[16];
+    for (int k = 0; k < 16; ++k) {
+        x[k] = B[k] = Xor(B[k], Bx[k]);
+    }
+
+    for (int i = 0; i < 8; i += 2) {
+        /* Operate on columns. */
+        x[ 4] = Xor(x[ 4], Rotl(Add(x[ 0], x[12]),  7));  x[ 9] = Xor(x[ 9], Rotl(Add(x[ 5], x[ 1]),  7));
+        x[14] = Xor(x[14], Rotl(Add(x[10], x[ 6]),  7));  x[ 3] = Xor(x[ 3], Rotl(Add(x[15], x[11]),  7));
+
+        x[ 8] = Xor(x[ 8], Rotl(Add(x[ 4], x[ 0]),  9));  x[13] = Xor(x[13], Rotl(Add(x[ 9], x[ 5]),  9));
+        x[ 2] = Xor(x[ 2], Rotl(Add(x[14], x[10]),  9));  x[ 7] = Xor(x[ 7], Rotl(Add(x[ 3], x[15]),  9));
+
+        x[12] = Xor(x[12], Rotl(Add(x[ 8], x[ 4]), 13));  x[ 1] = Xor(x[ 1], Rotl(Add(x[13], x[ 9]), 13));
+        x[ 6] = Xor(x[ 6], Rotl(Add(x[ 2], x[14]), 13));  x[11] = Xor(x[11], Rotl(Add(x[ 7], x[ 3]), 13));
+
+        x[ 0] = Xor(x[ 0], Rotl(Add(x[12], x[ 8]), 18));  x[ 5] = Xor(x[ 5], Rotl(Add(x[ 1], x[13]), 18));
+        x[10] = Xor(x[10], Rotl(Add(x[ 6], x[ 2]), 18));  x[15] = Xor(x[15], Rotl(Add(x[11], x[ 7]), 18));
+
+        /* Operate on rows. */
+        x[ 1] = Xor(x[ 1], Rotl(Add(x[ 0], x[ 3]),  7));  x[ 6] = Xor(x[ 6], Rotl(Add(x[ 5], x[ 4]),  7));
+        x[11] = Xor(x[11], Rotl(Add(x[10], x[ 9]),  7));  x[12] = Xor(x[12], Rotl(Add(x[15], x[14]),  7));
+
+        x[ 2] = Xor(x[ 2], Rotl(Add(x[ 1], x[ 0]),  9));  x[ 7] = Xor(x[ 7], Rotl(Add(x[ 6], x[ 5]),  9));
+        x[ 8] = Xor(x[ 8], Rotl(Add(x[11], x[10]),  9));  x[13] = Xor(x[13], Rotl(Add(x[12], x[15]),  9));
+
+        x[ 3] = Xor(x[ 3], Rotl(Add(x[ 2], x[ 1]), 13));  x[ 4] = Xor(x[ 4], Rotl(Add(x[ 7], x[ 6]), 13));
+        x[ 9] = Xor(x[ 9], Rotl(Add(x[ 8], x[11]), 13));  x[14] = Xor(x[14], Rotl(Add(x[13], x[12]), 13));
+
+        x[ 0] = Xor(x[ 0], Rotl(Add(x[ 3], x[ 2]), 18));  x[ 5] = Xor(x[ 5], Rotl(Add(x[ 4], x[ 7]), 18));
+        x[10] = Xor(x[10], Rotl(Add(x[ 9], x[ 8]), 18));  x[15] = Xor(x[15], Rotl(Add(x[14], x[13]), 18));
+    }
+
+    for (int k = 0; k < 16; ++k) {
+        B[k] = Add(B[k], x[k]);
+    }
+}
+
+}
+
+/**
+ * Runs ROMix over 8 independent scrypt states.
+ * X holds the 32 words of each state interleaved by lane (word k of lane l is at X[k * 8 + l]),
+ * and V must be 32-byte aligned with room for 1024 * 32 * 8 words.
+ */
+void ScryptCore_8way(uint32_t* X, uint32_t* V)
+{
+    __m256i x[32];
+    __m256i* v = (__m256i*)V;
+    for (int k = 0; k < 32; ++k) {
+        x[k] = _mm256_loadu_si256((const __m256i*)(X + k * 8));
+    }
+
+    for (int i = 0; i < 1024; ++i) {
+        for (int k = 0; k < 32; ++k) {
+            _mm256_store_si256(v + i * 32 + k, x[k]);
+        }
+        XorSalsa8(&x[0], &x[16]);
+        XorSalsa8(&x[16], &x[0]);
+    }
+
+    // Each lane reads from its own pseudo-random row of V, so the rows are gathered lane by lane.
+    const __m256i lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    const __m256i mask = _mm256_set1_epi32(1023);
+    for (int i = 0; i < 1024; ++i) {
+        const __m256i row = Add(_mm256_slli_epi32(_mm256_and_si256(x[16], mask), 8), lanes);
+        for (int k = 0; k < 32; ++k) {
+            const __m256i index = Add(row, _mm256_set1_epi32(k * 8));
+            x[k] = Xor(x[k], _mm256_i32gather_epi32((const int*)V, index, 4));
+        }
+        XorSalsa8(&x[0], &x[16]);
+        XorSalsa8(&x[16], &x[0]);
+    }
+
+    for (int k = 0; k < 32; ++k) {
+        _mm256_storeu_si256((__m256i*)(X + k * 8), x[k]);
+    }
+}
+
+}
+
+#endif
@@ -0,0 +1,103 @@
+// Copyright (c) 2021 The Litecoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+// An 16-way scrypt core for x86_64 using AVX-512 intrinsics, with one scrypt state per 32-bit lane.
+
+#ifdef ENABLE_AVX512
+
+#include <stdint.h>
+#include <immintrin.h>
+
+namespace scrypt_avx512 {
+namespace {
+
+__m512i inline Add(__m512i x, __m512i y) { return _mm512_add_epi32(x, y); }
+__m512i inline Xor(__m512i x, __m512i y) { return _mm512_xor_si512(x, y); }
+#define Rotl(x, n) _mm512_rol_epi32((x), (n))
+
+/** Salsa20/8 of B ^ Bx, added to B, in each of the 16 lanes. */
+void inline __attribute__((always_inline)) XorSalsa8(__m512i B[16], const __m512i Bx[16])
+{
+    __m512i x[16];
+    for (int k = 0; k < 16; ++k) {
+        x[k] = B[k] = Xor(B[k], Bx[k]);
+    }
+
+    for (int i = 0; i < 8; i += 2) {
+        /* Operate on columns. */
+        x[ 4] = Xor(x[ 4], Rotl(Add(x[ 0], x[12]),  7));  x[ 9] = Xor(x[ 9], Rotl(Add(x[ 5], x[ 1]),  7));
+        x[14] = Xor(x[14], Rotl(Add(x[10], x[ 6]),  7));  x[ 3] = Xor(x[ 3], Rotl(Add(x[15], x[11]),  7));
+
+        x[ 8] = Xor(x[ 8], Rotl(Add(x[ 4], x[ 0]),  9));  x[13] = Xor(x[13], Rotl(Add(x[ 9], x[ 5]),  9));
+        x[ 2] = Xor(x[ 2], Rotl(Add(x[14], x[10]),  9));  x[ 7] = Xor(x[ 7], Rotl(Add(x[ 3], x[15]),  9));
+
+        x[12] = Xor(x[12], Rotl(Add(x[ 8], x[ 4]), 13));  x[ 1] = Xor(x[ 1], Rotl(Add(x[13], x[ 9]), 13));
+        x[ 6] = Xor(x[ 6], Rotl(Add(x[ 2], x[14]), 13));  x[11] = Xor(x[11], Rotl(Add(x[ 7], x[ 3]), 13));
+
+        x[ 0] = Xor(x[ 0], Rotl(Add(x[12], x[ 8]), 18));  x[ 5] = Xor(x[ 5], Rotl(Add(x[ 1], x[13]), 18));
+        x[10] = Xor(x[10], Rotl(Add(x[ 6], x[ 2]), 18));  x[15] = Xor(x[15], Rotl(Add(x[11], x[ 7]), 18));
+
+        /* Operate on rows. */
+        x[ 1] = Xor(x[ 1], Rotl(Add(x[ 0], x[ 3]),  7));  x[ 6] = Xor(x[ 6], Rotl(Add(x[ 5], x[ 4]),  7));
+        x[11] = Xor(x[11], Rotl(Add(x[10], x[ 9]),  7));  x[12] = Xor(x[12], Rotl(Add(x[15], x[14]),  7));
+
+        x[ 2] = Xor(x[ 2], Rotl(Add(x[ 1], x[ 0]),  9));  x[ 7] = Xor(x[ 7], Rotl(Add(x[ 6], x[ 5]),  9));
+        x[ 8] = Xor(x[ 8], Rotl(Add(x[11], x[10]),  9));  x[13] = Xor(x[13], Rotl(Add(x[12], x[15]),  9));
+
+        x[ 3] = Xor(x[ 3], Rotl(Add(x[ 2], x[ 1]), 13));  x[ 4] = Xor(x[ 4], Rotl(Add(x[ 7], x[ 6]), 13));
+        x[ 9] = Xor(x[ 9], Rotl(Add(x[ 8], x[11]), 13));  x[14] = Xor(x[14], Rotl(Add(x[13], x[12]), 13));
+
+        x[ 0] = Xor(x[ 0], Rotl(Add(x[ 3], x[ 2]), 18));  x[ 5] = Xor(x[ 5], Rotl(Add(x[ 4], x[ 7]), 18));
+        x[10] = Xor(x[10], Rotl(Add(x[ 9], x[ 8]), 18));  x[15] = Xor(x[15], Rotl(Add(x[14], x[13]), 18));
+    }
+
+    for (int k = 0; k < 16; ++k) {
+        B[k] = Add(B[k], x[k]);
+    }
+}
+
+}
+
+/**
+ * Runs ROMix over 16 independent scrypt states.
+ * X holds the 32 words of each state interleaved by lane (word k of lane l is at X[k * 16 + l]),
+ * and V must be 64-byte aligned with room for 1024 * 32 * 16 words.
+ */
+void ScryptCore_16way(uint32_t* X, uint32_t* V)
+{
+    __m512i x[32];
+    __m512i* v = (__m512i*)V;
+    for (int k = 0; k < 32; ++k) {
+        x[k] = _mm512_loadu_si512(X + k * 16);
+    }
+
+    for (int i = 0; i < 1024; ++i) {
+        for (int k = 0; k < 32; ++k) {
+            _mm512_store_si512(v + i * 32 + k, x[k]);
+        }
+        XorSalsa8(&x[0], &x[16]);
+        XorSalsa8(&x[16], &x[0]);
+    }
+
+    // Each lane reads from its own pseudo-random row of V, so the rows are gathered lane by lane.
+    const __m512i lanes = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    const __m512i mask = _mm512_set1_epi32(1023);
+    for (int i = 0; i < 1024; ++i) {
+        const __m512i row = Add(_mm512_slli_epi32(_mm512_and_si512(x[16], mask), 9), lanes);
+        for (int k = 0; k < 32; ++k) {
+            const __m512i index = Add(row, _mm512_set1_epi32(k * 16));
+            x[k] = Xor(x[k], _mm512_i32gather_epi32(index, V, 4));
+        }
+        XorSalsa8(&x[0], &x[16]);
+        XorSalsa8(&x[16], &x[0]);
+    }
+
+    for (int k = 0; k < 32; ++k) {
+        _mm512_storeu_si512(X + k * 16, x[k]);
+    }
+}
+
+}
+
+#endif
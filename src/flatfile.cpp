@@ -3,6 +3,7 @@
 // Distributed under the MIT software license, see the accompanying
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
+#include <algorithm>
 #include <stdexcept>
 
 #include <flatfile.h>
@@ -10,6 +11,8 @@
 #include <tinyformat.h>
 #include <util/system.h>
 
+#include <mio/mmap.hpp>
+
 FlatFileSeq::FlatFileSeq(fs::path dir, const char* prefix, size_t chunk_size) :
     m_dir(std::move(dir)),
     m_prefix(prefix),
@@ -96,3 +99,50 @@ bool FlatFileSeq::Flush(const FlatFilePos& pos, bool finalize)
     fclose(file);
     return true;
 }
+
+FlatFileView FlatFileMapper::Read(const FlatFileSeq& seq, const FlatFilePos& pos, size_t size)
+{
+    if (pos.IsNull()) {
+        return {};
+    }
+    const fs::path path = seq.FileName(pos);
+    const uint64_t end = uint64_t{pos.nPos} + size;
+
+    LOCK(m_mutex);
+    auto it = std::find_if(m_mappings.begin(), m_mappings.end(), [&](const Mapping& mapping) { return mapping.path == path; });
+    if (it != m_mappings.end()) {
+        m_mappings.splice(m_mappings.begin(), m_mappings, it);
+    }
+
+    if (it == m_mappings.end() || end > it->data.size()) {
+        std::error_code error;
+        auto mmap = std::make_shared<mio::mmap_source>(mio::make_mmap_source(path.string(), error));
+        if (error) {
+            LogPrint(BCLog::VALIDATION, "%s: failed to map file %s: %s\n", __func__, path.string(), error.message());
+            if (it != m_mappings.end()) m_mappings.erase(it);
+            return {};
+        }
+
+        Mapping mapping{path, mmap, Span<const uint8_t>((const uint8_t*)mmap->data(), mmap->mapped_length())};
+        if (it != m_mappings.end()) {
+            *it = std::move(mapping);
+        } else {
+            m_mappings.push_front(std::move(mapping));
+            if (m_mappings.size() > m_max_files) m_mappings.pop_back();
+        }
+        it = m_mappings.begin();
+    }
+
+    if (end > it->data.size()) {
+        return {};
+    }
+    return FlatFileView(it->owner, it->data.subspan(pos.nPos, size));
+}
+
+void FlatFileMapper::Unmap(const FlatFileSeq& seq, const FlatFilePos& pos)
+{
+    const fs::path path = seq.FileName(pos);
+
+    LOCK(m_mutex);
+    m_mappings.remove_if([&](const Mapping& mapping) { return mapping.path == path; });
+}
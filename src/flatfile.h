@@ -6,10 +6,14 @@
 #ifndef BITCOIN_FLATFILE_H
 #define BITCOIN_FLATFILE_H
 
+#include <list>
+#include <memory>
 #include <string>
 
 #include <fs.h>
 #include <serialize.h>
+#include <span.h>
+#include <sync.h>
 
 struct FlatFilePos
 {
@@ -87,4 +91,56 @@ public:
     bool Flush(const FlatFilePos& pos, bool finalize = false);
 };
 
+/**
+ * A read-only view of a range of bytes, which keeps the memory mapping (or buffer) the bytes
+ * live in alive for as long as the view exists.
+ */
+class FlatFileView
+{
+private:
+    std::shared_ptr<const void> m_owner;
+    Span<const uint8_t> m_data;
+
+public:
+    FlatFileView() = default;
+    FlatFileView(std::shared_ptr<const void> owner, Span<const uint8_t> data) : m_owner(std::move(owner)), m_data(data) {}
+
+    bool IsNull() const { return m_owner == nullptr; }
+    Span<const uint8_t> Data() const { return m_data; }
+};
+
+/**
+ * FlatFileMapper keeps recently read files of a FlatFileSeq memory mapped, so data can be read from
+ * them without opening the file, seeking, and copying it through a stdio buffer each time. Up to
+ * max_files files are kept mapped, unmapping the least recently used one first.
+ */
+class FlatFileMapper
+{
+private:
+    struct Mapping
+    {
+        fs::path path;
+        std::shared_ptr<const void> owner;
+        Span<const uint8_t> data;
+    };
+
+    const size_t m_max_files;
+    Mutex m_mutex;
+    std::list<Mapping> m_mappings GUARDED_BY(m_mutex);
+
+public:
+    explicit FlatFileMapper(size_t max_files) : m_max_files(max_files) {}
+
+    /**
+     * Map size bytes of the file at the given position, remapping the file if it grew since it
+     * was mapped.
+     *
+     * @return A view of the bytes, or a null view if the file couldn't be mapped or is too short.
+     */
+    FlatFileView Read(const FlatFileSeq& seq, const FlatFilePos& pos, size_t size);
+
+    /** Unmap the file at the given position, e.g. before it is deleted. Existing views remain valid. */
+    void Unmap(const FlatFileSeq& seq, const FlatFilePos& pos);
+};
+
 #endif // BITCOIN_FLATFILE_H
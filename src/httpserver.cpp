@@ -569,6 +569,11 @@ void HTTPRequest::WriteHeader(const std::string& hdr, const std::string& value)
  * this cannot be done from worker threads.
  */
 void HTTPRequest::WriteReply(int nStatus, const std::string& strReply)
+{
+    WriteReply(nStatus, MakeUCharSpan(strReply));
+}
+
+void HTTPRequest::WriteReply(int nStatus, Span<const uint8_t> reply)
 {
     assert(!replySent && req);
     if (ShutdownRequested()) {
@@ -577,7 +582,7 @@ void HTTPRequest::WriteReply(int nStatus, const std::string& strReply)
     // Send event to main http thread to send reply message
     struct evbuffer* evb = evhttp_request_get_output_buffer(req);
     assert(evb);
-    evbuffer_add(evb, strReply.data(), strReply.size());
+    evbuffer_add(evb, reply.data(), reply.size());
     auto req_copy = req;
     HTTPEvent* ev = new HTTPEvent(eventBase, true, [req_copy, nStatus]{
         evhttp_send_reply(req_copy, nStatus, nullptr, nullptr);
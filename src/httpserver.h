@@ -8,6 +8,8 @@
 #include <string>
 #include <functional>
 
+#include <span.h>
+
 static const int DEFAULT_HTTP_THREADS=4;
 static const int DEFAULT_HTTP_WORKQUEUE=16;
 static const int DEFAULT_HTTP_SERVER_TIMEOUT=30;
@@ -113,6 +115,7 @@ public:
      * main thread, do not call any other HTTPRequest methods after calling this.
      */
     void WriteReply(int nStatus, const std::string& strReply = "");
+    void WriteReply(int nStatus, Span<const uint8_t> reply);
 };
 
 /** Event handler closure.
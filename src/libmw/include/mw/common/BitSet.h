@@ -101,4 +101,84 @@ struct BitSet : public Traits::ISerializable
         ::Unserialize(s, vec);
         *this = BitSet::From(vec);
     }
+};
+
+/// <summary>
+/// A read-only copy of a BitSet, indexed to answer rank queries in constant time.
+/// The number of set bits preceding every 512-bit superblock is precomputed,
+/// so a query only needs to popcount at most 8 words.
+/// </summary>
+class RankIndexedBitSet
+{
+public:
+    RankIndexedBitSet() = default;
+    explicit RankIndexedBitSet(const BitSet& bitset)
+        : m_size(bitset.size()), m_words((bitset.size() + 63) / 64, 0)
+    {
+        for (size_t i = bitset.bitset.find_first(); i != boost::dynamic_bitset<>::npos; i = bitset.bitset.find_next(i)) {
+            m_words[i / 64] |= (uint64_t(1) << (i % 64));
+        }
+
+        m_superblocks.reserve((m_words.size() / WORDS_PER_SUPERBLOCK) + 1);
+
+        uint64_t rank = 0;
+        for (size_t w = 0; w < m_words.size(); w++) {
+            if (w % WORDS_PER_SUPERBLOCK == 0) {
+                m_superblocks.push_back(rank);
+            }
+
+            rank += popcount(m_words[w]);
+        }
+
+        m_count = rank;
+    }
+
+    bool test(uint64_t idx) const noexcept { return m_size > idx && ((m_words[idx / 64] >> (idx % 64)) & 1); }
+    uint64_t count() const noexcept { return m_count; }
+    uint64_t size() const noexcept { return m_size; }
+
+    /// <summary>
+    /// Calculates the number of set bits that are smaller than idx.
+    /// </summary>
+    /// <param name="idx">The index to calculate the rank for.</param>
+    /// <returns>The calculated rank.</returns>
+    uint64_t rank(uint64_t idx) const noexcept
+    {
+        if (idx >= m_size) {
+            return m_count;
+        }
+
+        const size_t word_idx = idx / 64;
+        const size_t superblock_idx = word_idx / WORDS_PER_SUPERBLOCK;
+
+        uint64_t rank = m_superblocks[superblock_idx];
+        for (size_t w = superblock_idx * WORDS_PER_SUPERBLOCK; w < word_idx; w++) {
+            rank += popcount(m_words[w]);
+        }
+
+        const uint64_t mask = (uint64_t(1) << (idx % 64)) - 1;
+        return rank + popcount(m_words[word_idx] & mask);
+    }
+
+private:
+    static constexpr size_t WORDS_PER_SUPERBLOCK = 8;
+
+    // Built for the baseline target, so this is a portable popcount rather than a POPCNT instruction.
+    // At most 8 are needed per rank query, which keeps it constant-time either way.
+    static uint64_t popcount(uint64_t x) noexcept
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_popcountll(x);
+#else
+        x = x - ((x >> 1) & 0x5555555555555555ULL);
+        x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+        x = (x + (x >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+        return (x * 0x0101010101010101ULL) >> 56;
+#endif
+    }
+
+    uint64_t m_size{0};
+    uint64_t m_count{0};
+    std::vector<uint64_t> m_words;
+    std::vector<uint64_t> m_superblocks;
 };
\ No newline at end of file
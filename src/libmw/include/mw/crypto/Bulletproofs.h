@@ -6,6 +6,7 @@
 #include <mw/models/crypto/RangeProof.h>
 #include <mw/models/crypto/RewoundProof.h>
 #include <mw/models/crypto/SecretKey.h>
+#include <mw/crypto/VerificationCache.h>
 #include <memory>
 
 class Bulletproofs
@@ -15,6 +16,14 @@ public:
         const std::vector<ProofData>& rangeProofs
     );
 
+    //
+    // Salts the cache of verified rangeproofs with nonce and resizes it to use no more than max_bytes.
+    // The cache is disabled until this is called.
+    // Returns the number of rangeproofs the cache can hold.
+    //
+    static size_t InitCache(const uint256& nonce, const size_t max_bytes);
+    static VerificationCache::Stats GetCacheStats();
+
     static RangeProof::CPtr Generate(
         const uint64_t amount,
         const SecretKey& key,
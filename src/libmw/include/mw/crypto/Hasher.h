@@ -75,4 +75,33 @@ template<class T>
 mw::Hash Hashed(const EHashTag tag, const T& serializable)
 {
     return Hasher(tag).Append(serializable).hash();
+}
+
+/// <summary>
+/// Hashes many messages of the same length at once, using BLAKE3's multi-input kernels.
+/// Equivalent to calling Hashed() on each message, but much faster for large batches of
+/// small messages, such as the parent nodes of an MMR.
+/// </summary>
+/// <param name="inputs">Pointers to the messages.</param>
+/// <param name="len">The length of every message. Must be in (0, 1024].</param>
+/// <returns>The hashes, in the same order as the inputs.</returns>
+extern std::vector<mw::Hash> HashedMany(const std::vector<const uint8_t*>& inputs, const size_t len);
+
+/// <summary>
+/// Low-level access to the BLAKE3 hash tree, for callers that cache the chaining values
+/// of unchanged subtrees and only rehash the chunks that were modified.
+/// Combining the chaining values per the BLAKE3 tree layout yields the same hash as Hashed().
+/// </summary>
+namespace blake3_tree
+{
+    static constexpr uint64_t CHUNK_LEN = BLAKE3_CHUNK_LEN;
+
+    // Chaining value of a non-root chunk. len must be in (0, CHUNK_LEN].
+    mw::Hash ChunkCV(const uint8_t* pChunk, const size_t len, const uint64_t chunk_counter);
+
+    // Chaining value of a non-root parent node.
+    mw::Hash ParentCV(const mw::Hash& left, const mw::Hash& right);
+
+    // Root hash of an input spanning more than one chunk.
+    mw::Hash ParentRoot(const mw::Hash& left, const mw::Hash& right);
 }
\ No newline at end of file
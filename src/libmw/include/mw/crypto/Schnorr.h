@@ -6,6 +6,7 @@
 #include <mw/models/crypto/PublicKey.h>
 #include <mw/models/crypto/Hash.h>
 #include <mw/models/crypto/SignedMessage.h>
+#include <mw/crypto/VerificationCache.h>
 
 class Schnorr
 {
@@ -33,4 +34,12 @@ public:
     static bool BatchVerify(
         const std::vector<SignedMessage>& signatures
     );
+
+    //
+    // Salts the cache of verified signatures with nonce and resizes it to use no more than max_bytes.
+    // The cache is disabled until this is called.
+    // Returns the number of signatures the cache can hold.
+    //
+    static size_t InitCache(const uint256& nonce, const size_t max_bytes);
+    static VerificationCache::Stats GetCacheStats();
 };
\ No newline at end of file
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <crypto/sha256.h>
+#include <cuckoocache.h>
+#include <uint256.h>
+
+#include <boost/thread/shared_mutex.hpp>
+#include <array>
+#include <atomic>
+#include <cstring>
+
+/// <summary>
+/// A salted, fixed-memory cache of successful signature or rangeproof verifications,
+/// modeled after the script signature cache.
+/// Entries are split across independently locked CuckooCache shards, so concurrent lookups
+/// only ever share a read lock, and inserts only contend with other inserts into the same shard.
+/// The cache is disabled until Setup is called, which the node does from init, like InitSignatureCache.
+/// </summary>
+class VerificationCache
+{
+public:
+    struct Stats
+    {
+        uint64_t hits;
+        uint64_t misses;
+        size_t max_elements;
+    };
+
+    VerificationCache();
+
+    /// <summary>
+    /// Returns a copy of the salted hasher. Callers write the verified data to it and
+    /// finalize it to compute the cache entry, so entries can't be predicted by peers.
+    /// </summary>
+    CSHA256 GetSaltedHasher() const noexcept { return m_saltedHasher; }
+
+    /// <summary>
+    /// Checks whether the entry was previously inserted, updating the hit/miss counters.
+    /// </summary>
+    /// <param name="entry">The entry computed using the salted hasher.</param>
+    /// <param name="erase">Marks the entry as eligible for eviction when found.</param>
+    bool Contains(const uint256& entry, const bool erase);
+    void Insert(uint256 entry);
+
+    /// <summary>
+    /// Salts the cache with the nonce and resizes it to use no more than the given number of bytes,
+    /// discarding any existing entries.
+    /// Not thread-safe. Must be called before the cache is shared between threads.
+    /// </summary>
+    /// <param name="nonce">A random nonce, so entries can't be predicted by peers.</param>
+    /// <param name="bytes">The maximum number of bytes the cache can use.</param>
+    /// <returns>The maximum number of elements the cache can hold.</returns>
+    size_t Setup(const uint256& nonce, const size_t bytes);
+
+    Stats GetStats() const noexcept;
+
+private:
+    static constexpr size_t NUM_SHARDS = 16;
+
+    class Hasher
+    {
+    public:
+        template <uint8_t hash_select>
+        uint32_t operator()(const uint256& key) const
+        {
+            static_assert(hash_select < 8, "VerificationCache::Hasher only has 8 hashes available.");
+            uint32_t u;
+            std::memcpy(&u, key.begin() + 4 * hash_select, 4);
+            return u;
+        }
+    };
+
+    struct Shard
+    {
+        CuckooCache::cache<uint256, Hasher> entries;
+        boost::shared_mutex mutex;
+    };
+
+    // The low byte of the first hash barely affects an entry's position within a shard, so it's used to pick the shard.
+    Shard& GetShard(const uint256& entry) noexcept { return m_shards[entry.begin()[0] % NUM_SHARDS]; }
+
+    CSHA256 m_saltedHasher;
+    std::array<Shard, NUM_SHARDS> m_shards;
+    size_t m_maxElements;
+    std::atomic<uint64_t> m_hits;
+    std::atomic<uint64_t> m_misses;
+};
\ No newline at end of file
@@ -7,17 +7,54 @@
 // Forward Declarations
 class Database;
 
+//
+// Iterates over the UTXOs in the database, in output ID order.
+// UTXOs are returned without their rangeproofs.
+// Reads from the database as it was when the cursor was created, so writes made while iterating aren't seen.
+//
+class UTXOCursor
+{
+public:
+	explicit UTXOCursor(std::unique_ptr<mw::DBIterator> pIter);
+	~UTXOCursor();
+
+	bool Valid() const;
+	void Next();
+
+	//
+	// Deserializes the current UTXO.
+	// Returns nullptr if the value can't be read.
+	//
+	UTXO::CPtr GetUTXO() const;
+
+private:
+	std::unique_ptr<mw::DBIterator> m_pIter;
+};
+
 class CoinDB
 {
 public:
 	using UPtr = std::unique_ptr<CoinDB>;
 
+	//
+	// Version of the coin database format written by this binary.
+	// Version 1 stores compact UTXOs, with their rangeproofs in the ProofDB.
+	//
+	static constexpr uint32_t CURRENT_VERSION = 1;
+
 	CoinDB(mw::DBWrapper* pDBWrapper, mw::DBBatch* pBatch = nullptr);
 	~CoinDB();
 
+	//
+	// Returns the version of the coin database format.
+	// Databases written before the format was versioned are version 0.
+	//
+	uint32_t GetVersion() const;
+
 	//
 	// Retrieve UTXOs with matching output IDs.
 	// If there are multiple UTXOs for an output ID, the most recent will be returned.
+	// Lookups are sorted by key and performed in a single database iterator sweep.
 	//
 	std::unordered_map<mw::Hash, UTXO::CPtr> GetUTXOs(
 		const std::vector<mw::Hash>& output_ids
@@ -41,6 +78,22 @@ public:
 	//
 	void RemoveAllUTXOs();
 
+	//
+	// Rewrites UTXOs stored in the legacy format, which embedded the full output, as compact UTXOs
+	// keyed by the raw 32-byte output ID, moving their rangeproofs into the ProofDB.
+	// Handles UTXOs stored under both the hex-encoded and the raw output ID keys.
+	// Must not be called on a CoinDB with a pending batch, since it commits its own batches.
+	// Sets the database version to CURRENT_VERSION once all UTXOs are migrated.
+	// Returns the number of UTXOs migrated, which is 0 once the database has been upgraded.
+	//
+	size_t MigrateLegacyUTXOs();
+
+	//
+	// Opens a cursor over all of the UTXOs.
+	//
+	std::unique_ptr<UTXOCursor> NewCursor() const;
+
 private:
+	mw::DBWrapper* m_pDBWrapper;
 	std::unique_ptr<Database> m_pDatabase;
 };
\ No newline at end of file
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <mw/mmr/LeafIndex.h>
+#include <mw/models/crypto/RangeProof.h>
+#include <mw/interfaces/db_interface.h>
+#include <vector>
+
+// Forward Declarations
+class Database;
+
+/// <summary>
+/// Stores the rangeproofs of the MWEB UTXOs, keyed by leaf index.
+/// Keys are big-endian, so proofs of newly added outputs are always appended to the end of the table.
+/// Kept apart from the UTXOs themselves, which are only ever looked up to validate spends.
+/// </summary>
+class ProofDB
+{
+public:
+    ProofDB(mw::DBWrapper* pDBWrapper, mw::DBBatch* pBatch = nullptr);
+    ~ProofDB();
+
+    /// <summary>
+    /// Retrieves the rangeproof of the output at the given leaf index.
+    /// </summary>
+    /// <returns>The rangeproof. nullptr if not found.</returns>
+    RangeProof::CPtr Get(const mmr::LeafIndex& idx) const;
+
+    void Add(const std::vector<std::pair<mmr::LeafIndex, RangeProof::CPtr>>& proofs);
+    void Remove(const std::vector<mmr::LeafIndex>& indices);
+    void RemoveAll();
+
+private:
+    std::unique_ptr<Database> m_pDatabase;
+};
\ No newline at end of file
@@ -3,53 +3,122 @@
 #include <mw/file/File.h>
 #include <mw/file/FilePath.h>
 #include <mw/file/MemMap.h>
+#include <serialize.h>
+#include <algorithm>
+#include <functional>
+#include <memory>
 
+/// <summary>
+/// A file that is only appended to or rewound, with the uncommitted bytes held in memory.
+/// The committed bytes are split into segments, each stored in a data file of its own.
+/// Data files are shared between commits, each of which only owns a prefix of them,
+/// so bytes past the end of a segment are never truncated or overwritten.
+/// </summary>
 class AppendOnlyFile
 {
 public:
     using Ptr = std::shared_ptr<AppendOnlyFile>;
 
-    AppendOnlyFile(const File& file, const size_t fileSize) noexcept
-        : m_file(file),
-        m_mmap(file.GetPath()),
-        m_fileSize(fileSize),
-        m_bufferIndex(fileSize)
+    /// <summary>
+    /// The committed bytes [begin, end) of the file, stored from the start of data file file_index.
+    /// </summary>
+    struct Segment
     {
+        uint32_t file_index;
+        uint64_t begin;
+        uint64_t end;
 
-    }
+        SERIALIZE_METHODS(Segment, obj) { READWRITE(obj.file_index, obj.begin, obj.end); }
+    };
+
+    using GetPathFn = std::function<FilePath(const uint32_t file_index)>;
+
+    AppendOnlyFile(GetPathFn get_path) noexcept
+        : m_getPath(std::move(get_path)), m_fileSize(0), m_bufferIndex(0) { }
     virtual ~AppendOnlyFile() = default;
 
-    static AppendOnlyFile::Ptr Load(const FilePath& path)
+    /// <summary>
+    /// Loads the committed bytes described by the segments, which must be contiguous and start at 0.
+    /// Any bytes past the end of the last segment are left alone. They either belong to a commit
+    /// that was never finalized, or to a later commit sharing the data file.
+    /// </summary>
+    static AppendOnlyFile::Ptr Load(const GetPathFn& get_path, const std::vector<Segment>& segments)
     {
-        File file(path);
-        file.Create();
+        auto pAppendOnlyFile = std::make_shared<AppendOnlyFile>(get_path);
+
+        uint64_t next_begin = 0;
+        for (const Segment& segment : segments) {
+            File file(get_path(segment.file_index));
+            if (segment.begin != next_begin || segment.end < segment.begin) {
+                ThrowFile_F("Segment of {} is not contiguous with the previous one", file);
+            }
+
+            file.Create();
+            if (file.GetSize() < segment.end - segment.begin) {
+                ThrowFile_F("{} is smaller than its committed size of {} bytes", file, segment.end - segment.begin);
+            }
 
-        auto pAppendOnlyFile = std::make_shared<AppendOnlyFile>(file, file.GetSize());
-        pAppendOnlyFile->m_mmap.Map();
+            pAppendOnlyFile->m_segments.push_back(MapSegment(file, segment));
+            next_begin = segment.end;
+        }
+
+        pAppendOnlyFile->m_fileSize = next_begin;
+        pAppendOnlyFile->m_bufferIndex = next_begin;
         return pAppendOnlyFile;
     }
 
-    void Commit(const FilePath& new_path)
+    /// <summary>
+    /// Writes the buffered bytes to disk, without touching bytes committed by earlier commits.
+    /// When the last segment is the only user of its data file's tail, the buffer is appended in place.
+    /// Otherwise, e.g. after rewinding below the committed size, only the buffer is written,
+    /// to the new data file new_file_index. Once there are MAX_SEGMENTS segments,
+    /// all retained bytes are consolidated into the new data file instead.
+    /// </summary>
+    /// <param name="new_file_index">The data file to write to if the buffer can't be appended in place.</param>
+    void Commit(const uint32_t new_file_index)
     {
         if (m_fileSize < m_bufferIndex) {
-            ThrowFile_F("Buffer index is past the end of {}", m_file);
+            ThrowFile_F("Buffer index is past the end of {}", m_getPath(new_file_index));
         }
 
-        m_mmap.Unmap();
+        // Segments past the buffer index were rewound. Their data files are left intact for earlier commits.
+        while (m_segments.size() > 1 && m_segments.back().segment.begin >= m_bufferIndex) {
+            m_segments.pop_back();
+        }
+        if (!m_segments.empty() && m_segments.back().segment.end > m_bufferIndex) {
+            m_segments.back().segment.end = m_bufferIndex;
+        }
+        m_fileSize = m_bufferIndex;
 
-        m_file.CopyTo(new_path);
-        m_file = File(new_path);
+        if (m_buffer.empty()) {
+            return;
+        }
 
-        if (m_fileSize != m_bufferIndex || !m_buffer.empty()) {
-            m_file.Write(m_bufferIndex, m_buffer, true);
-            m_fileSize = m_file.GetSize();
+        if (m_segments.size() >= MAX_SEGMENTS) {
+            std::vector<uint8_t> bytes;
+            bytes.reserve(m_bufferIndex + m_buffer.size());
+            for (const MappedSegment& mapped : m_segments) {
+                Span<const uint8_t> segment_bytes = mapped.pMap->ReadSpan(0, mapped.segment.end - mapped.segment.begin);
+                bytes.insert(bytes.end(), segment_bytes.begin(), segment_bytes.end());
+            }
+            bytes.insert(bytes.end(), m_buffer.cbegin(), m_buffer.cend());
+
+            m_segments.clear();
+            m_segments.push_back(WriteSegment(new_file_index, 0, bytes));
+        } else if (m_segments.empty() || !OwnsTail(m_segments.back())) {
+            m_segments.push_back(WriteSegment(new_file_index, m_bufferIndex, m_buffer));
+        } else {
+            MappedSegment& last = m_segments.back();
+            last.pMap->Unmap();
+            File file = last.pMap->GetFile();
+            file.Write(m_buffer);
+            last.segment.end += m_buffer.size();
+            last = MapSegment(file, last.segment);
         }
 
+        m_fileSize = m_bufferIndex + m_buffer.size();
         m_bufferIndex = m_fileSize;
         m_buffer.clear();
-
-        m_mmap = MemMap{ m_file };
-        m_mmap.Map();
     }
 
     void Rollback() noexcept
@@ -69,7 +138,7 @@ public:
 
         if (nextPosition > (m_bufferIndex + m_buffer.size()))
         {
-            ThrowFile_F("Tried to rewind past end of {}", m_file);
+            ThrowFile_F("Tried to rewind past end of file {}", m_segments.empty() ? 0 : m_segments.back().segment.file_index);
         }
 
         if (nextPosition <= m_bufferIndex)
@@ -83,36 +152,111 @@ public:
         }
     }
 
+    /// <summary>
+    /// Returns the segments holding the committed bytes, in order.
+    /// </summary>
+    std::vector<Segment> GetSegments() const
+    {
+        std::vector<Segment> segments;
+        for (const MappedSegment& mapped : m_segments) {
+            segments.push_back(mapped.segment);
+        }
+
+        return segments;
+    }
+
     uint64_t GetSize() const noexcept
     {
         return m_bufferIndex + m_buffer.size();
     }
 
     std::vector<uint8_t> Read(const uint64_t position, const uint64_t numBytes) const
+    {
+        Span<const uint8_t> bytes = ReadSpan(position, numBytes);
+        return std::vector<uint8_t>(bytes.begin(), bytes.end());
+    }
+
+    /// <summary>
+    /// Returns the bytes without copying them, either from the mapped data files or,
+    /// for bytes that haven't been committed yet, from the in-memory buffer.
+    /// The span is invalidated by the next Append, Rewind, Commit, or Rollback.
+    /// </summary>
+    /// <throws>FileException if the range is past the end of the file, or spans more than one segment or the buffer.</throws>
+    Span<const uint8_t> ReadSpan(const uint64_t position, const uint64_t numBytes) const
     {
         if ((position + numBytes) > (m_bufferIndex + m_buffer.size()))
         {
-            ThrowFile_F("Tried to read past end of {}", m_file);
+            ThrowFile_F("Tried to read past end of file at position {}", position);
         }
 
         if (position < m_bufferIndex)
         {
-            // FUTURE: Read from mapped and then from buffer, if necessary
-            return m_mmap.Read(position, numBytes);
+            auto iter = std::upper_bound(
+                m_segments.cbegin(), m_segments.cend(), position,
+                [](const uint64_t pos, const MappedSegment& mapped) { return pos < mapped.segment.begin; }
+            );
+            assert(iter != m_segments.cbegin());
+            const MappedSegment& mapped = *(--iter);
+
+            // Callers read whole hashes, and segments and the buffer always start on a hash boundary.
+            if (position + numBytes > std::min(mapped.segment.end, m_bufferIndex))
+            {
+                ThrowFile_F("Tried to read across the end of {}", mapped.pMap->GetFile());
+            }
+
+            return mapped.pMap->ReadSpan(position - mapped.segment.begin, numBytes);
         }
         else
         {
-            auto begin = m_buffer.cbegin() + position - m_bufferIndex;
-            auto end = begin + numBytes;
-            return std::vector<uint8_t>(begin, end);
+            return Span<const uint8_t>(m_buffer.data() + (position - m_bufferIndex), numBytes);
         }
     }
 
 private:
-    File m_file;
-    MemMap m_mmap;
+    // Segments a file can be split into before the next commit consolidates them.
+    static constexpr size_t MAX_SEGMENTS = 16;
+
+    struct MappedSegment
+    {
+        Segment segment;
+        std::shared_ptr<MemMap> pMap;
+    };
+
+    static MappedSegment MapSegment(const File& file, const Segment& segment)
+    {
+        auto pMap = std::make_shared<MemMap>(file);
+        pMap->Map();
+        return MappedSegment{ segment, pMap };
+    }
+
+    // True if nothing follows the segment's bytes in its data file,
+    // so appending to it can't overwrite bytes committed by another commit.
+    static bool OwnsTail(const MappedSegment& mapped)
+    {
+        return mapped.pMap->GetFile().GetSize() == mapped.segment.end - mapped.segment.begin;
+    }
+
+    MappedSegment WriteSegment(const uint32_t file_index, const uint64_t begin, const std::vector<uint8_t>& bytes)
+    {
+        for (const MappedSegment& mapped : m_segments) {
+            if (mapped.segment.file_index == file_index) {
+                ThrowFile_F("Data file {} is still in use", mapped.pMap->GetFile());
+            }
+        }
+
+        File file(m_getPath(file_index));
+        if (file.Exists()) {
+            file.GetPath().Remove();
+        }
+        file.Write(bytes);
+
+        return MapSegment(file, Segment{ file_index, begin, begin + bytes.size() });
+    }
+
+    GetPathFn m_getPath;
+    std::vector<MappedSegment> m_segments;
     uint64_t m_fileSize;
 
     uint64_t m_bufferIndex;
     std::vector<uint8_t> m_buffer;
-};
\ No newline at end of file
+};
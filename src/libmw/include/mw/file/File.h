@@ -25,6 +25,10 @@ public:
     void WriteBytes(const std::unordered_map<uint64_t, uint8_t>& bytes);
     void Truncate(const uint64_t size);
 
+    // Replaces the file's contents by writing them to a temporary file and renaming it over this one,
+    // so the file either holds its old or its new contents if writing is interrupted.
+    void Replace(const std::vector<uint8_t>& bytes);
+
     void CopyTo(const FilePath& new_path) const;
 
     //
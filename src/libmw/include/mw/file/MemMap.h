@@ -15,6 +15,7 @@
 #endif
 
 #include <mw/file/File.h>
+#include <span.h>
 #include <cassert>
 
 class MemMap
@@ -47,9 +48,20 @@ public:
     }
 
     std::vector<uint8_t> Read(const size_t position, const size_t numBytes) const
+    {
+        Span<const uint8_t> bytes = ReadSpan(position, numBytes);
+        return std::vector<uint8_t>(bytes.begin(), bytes.end());
+    }
+
+    /// <summary>
+    /// Returns the mapped bytes without copying them.
+    /// The span is invalidated when the file is unmapped.
+    /// </summary>
+    Span<const uint8_t> ReadSpan(const size_t position, const size_t numBytes) const
     {
         assert(m_mapped);
-        return std::vector<uint8_t>(m_mmap.cbegin() + position, m_mmap.cbegin() + position + numBytes);
+        assert(position + numBytes <= m_mmap.size());
+        return Span<const uint8_t>((const uint8_t*)m_mmap.data() + position, numBytes);
     }
 
     uint8_t ReadByte(const size_t position) const
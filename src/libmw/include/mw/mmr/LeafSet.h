@@ -6,6 +6,8 @@
 #include <mw/file/MemMap.h>
 #include <mw/models/crypto/Hash.h>
 #include <mw/mmr/LeafIndex.h>
+#include <map>
+#include <set>
 #include <unordered_map>
 
 class ILeafSet
@@ -21,6 +23,12 @@ public:
     void Add(const mmr::LeafIndex& idx);
     void Remove(const mmr::LeafIndex& idx);
     bool Contains(const mmr::LeafIndex& idx) const noexcept;
+
+    /// <summary>
+    /// Calculates the BLAKE3 hash of the leafset bitmap.
+    /// The bitmap is hashed as a BLAKE3 tree of 1KB chunks, and the chaining values of complete subtrees are cached,
+    /// so only chunks modified since the last call are rehashed.
+    /// </summary>
     mw::Hash Root() const;
     void Rewind(const uint64_t numLeaves, const std::vector<mmr::LeafIndex>& leavesToAdd);
     const mmr::LeafIndex& GetNextLeafIdx() const noexcept { return m_nextLeafIdx; }
@@ -33,13 +41,33 @@ public:
         const std::unordered_map<uint64_t, uint8_t>& modifiedBytes
     ) = 0;
 
+    // Copies the bitmap bytes in the range [byteIdx, byteIdx + numBytes) to pOut.
+    virtual void ReadBytes(const uint64_t byteIdx, const size_t numBytes, uint8_t* pOut) const;
+
+    // Returns the BLAKE3 chaining value of the complete subtree of 2^height full chunks, starting at chunk (index << height).
+    virtual mw::Hash GetSubtreeCV(const uint8_t height, const uint64_t index) const;
+
+    // Incremented every time a byte of the bitmap is modified, including in any backing leafset.
+    virtual uint64_t GetChangeCount() const noexcept { return m_changeCount; }
+
 protected:
     uint8_t BitToByte(const uint8_t bit) const;
 
+    // Invalidates the cached chaining values of the chunk containing the given byte, and all of its ancestors.
+    void MarkDirty(const uint64_t byteIdx);
+    void ClearSubtreeCache() const;
+
     ILeafSet(const mmr::LeafIndex& nextLeafIdx)
-        : m_nextLeafIdx(nextLeafIdx) { }
+        : m_nextLeafIdx(nextLeafIdx), m_changeCount(0) { }
 
     mmr::LeafIndex m_nextLeafIdx;
+
+private:
+    mw::Hash CalcRangeCV(const uint64_t firstChunk, const uint64_t numChunks, const uint64_t numBytes) const;
+
+    uint64_t m_changeCount;
+    mutable std::set<uint64_t> m_dirtyChunks;
+    mutable std::map<std::pair<uint8_t, uint64_t>, mw::Hash> m_subtreeCVs;
 };
 
 class LeafSet : public ILeafSet
@@ -52,6 +80,7 @@ public:
 
     uint8_t GetByte(const uint64_t byteIdx) const final;
     void SetByte(const uint64_t byteIdx, const uint8_t value) final;
+    void ReadBytes(const uint64_t byteIdx, const size_t numBytes, uint8_t* pOut) const final;
 
     void ApplyUpdates(
         const uint32_t file_index,
@@ -77,10 +106,15 @@ public:
     using UPtr = std::unique_ptr<LeafSetCache>;
 
     LeafSetCache(const ILeafSet::Ptr& pBacked)
-        : ILeafSet(pBacked->GetNextLeafIdx()), m_pBacked(pBacked) { }
+        : ILeafSet(pBacked->GetNextLeafIdx()), m_pBacked(pBacked), m_backedChangeCount(pBacked->GetChangeCount()) { }
 
     uint8_t GetByte(const uint64_t byteIdx) const final;
     void SetByte(const uint64_t byteIdx, const uint8_t value) final;
+    void ReadBytes(const uint64_t byteIdx, const size_t numBytes, uint8_t* pOut) const final;
+
+    // Subtrees containing no chunks modified in this cache are served by the backing leafset.
+    mw::Hash GetSubtreeCV(const uint8_t height, const uint64_t index) const final;
+    uint64_t GetChangeCount() const noexcept final { return ILeafSet::GetChangeCount() + m_pBacked->GetChangeCount(); }
 
     void ApplyUpdates(
         const uint32_t file_index,
@@ -92,4 +126,6 @@ public:
 private:
     ILeafSet::Ptr m_pBacked;
     std::unordered_map<uint64_t, uint8_t> m_modifiedBytes;
+    std::set<uint64_t> m_modifiedChunks;
+    mutable uint64_t m_backedChangeCount;
 };
\ No newline at end of file
@@ -12,6 +12,7 @@
 #include <mw/mmr/Leaf.h>
 #include <mw/mmr/PruneList.h>
 #include <mw/interfaces/db_interface.h>
+#include <span.h>
 
 /// <summary>
 /// An interface for interacting with MMRs.
@@ -31,6 +32,14 @@ public:
     mmr::LeafIndex Add(const std::vector<uint8_t>& data) { return AddLeaf(mmr::Leaf::Create(GetNextLeafIdx(), data)); }
     mmr::LeafIndex Add(const Traits::ISerializable& serializable) { return AddLeaf(mmr::Leaf::Create(GetNextLeafIdx(), serializable.Serialized())); }
 
+    /// <summary>
+    /// Adds the given leaves to the end of the MMR.
+    /// Same result as calling AddLeaf for each leaf, but parent hashes are calculated
+    /// a whole height at a time, and the new hashes are appended in one contiguous write.
+    /// </summary>
+    /// <param name="leaves">Consecutive leaves, starting at GetNextLeafIdx().</param>
+    virtual void AddLeaves(const Span<const mmr::Leaf>& leaves) = 0;
+
     /// <summary>
     /// Retrieves the leaf at the given leaf index.
     /// </summary>
@@ -49,6 +58,15 @@ public:
     /// <throws>std::exception if node at the given index has been pruned.</throws>
     virtual mw::Hash GetHash(const mmr::Index& idx) const = 0;
 
+    /// <summary>
+    /// Same as GetHash, but returns a view of the stored hash instead of a copy,
+    /// so lookups in tight loops (root calculation, parent hashing) don't allocate.
+    /// The view is only valid until the MMR is next modified.
+    /// </summary>
+    /// <param name="idx">The index, which may or may not be a leaf.</param>
+    /// <returns>A view of the hash of the leaf or node at the index.</returns>
+    virtual mw::HashView GetHashView(const mmr::Index& idx) const = 0;
+
     /// <summary>
     /// Retrieves the index of the next leaf to be added to the MMR.
     /// eg. If the MMR contains 3 leaves (0, 1, 2), this will return LeafIndex 3.
@@ -115,8 +133,10 @@ public:
     virtual ~MemMMR() = default;
 
     mmr::LeafIndex AddLeaf(const mmr::Leaf& leaf) final;
+    void AddLeaves(const Span<const mmr::Leaf>& leaves) final;
     mmr::Leaf GetLeaf(const mmr::LeafIndex& leafIdx) const final;
     mw::Hash GetHash(const mmr::Index& idx) const final;
+    mw::HashView GetHashView(const mmr::Index& idx) const final;
 
     mmr::LeafIndex GetNextLeafIdx() const noexcept final;
     uint64_t GetNumLeaves() const noexcept final;
@@ -161,11 +181,14 @@ public:
     virtual ~PMMR() = default;
 
     static FilePath GetPath(const FilePath& dir, const char prefix, const uint32_t file_index);
+    static FilePath GetManifestPath(const FilePath& dir, const char prefix, const uint32_t file_index);
 
     mmr::LeafIndex AddLeaf(const mmr::Leaf& leaf) final;
+    void AddLeaves(const Span<const mmr::Leaf>& leaves) final;
 
     mmr::Leaf GetLeaf(const mmr::LeafIndex& leafIdx) const final;
     mw::Hash GetHash(const mmr::Index& idx) const final;
+    mw::HashView GetHashView(const mmr::Index& idx) const final;
     mmr::LeafIndex GetNextLeafIdx() const noexcept final { return mmr::LeafIndex::At(GetNumLeaves()); }
 
     uint64_t GetNumLeaves() const noexcept final;
@@ -200,11 +223,13 @@ public:
     virtual ~PMMRCache() = default;
 
     mmr::LeafIndex AddLeaf(const mmr::Leaf& leaf) final;
+    void AddLeaves(const Span<const mmr::Leaf>& leaves) final;
 
     mmr::Leaf GetLeaf(const mmr::LeafIndex& leafIdx) const final;
     mmr::LeafIndex GetNextLeafIdx() const noexcept final;
     uint64_t GetNumLeaves() const noexcept final { return GetNextLeafIdx().Get(); }
     mw::Hash GetHash(const mmr::Index& idx) const final;
+    mw::HashView GetHashView(const mmr::Index& idx) const final;
 
     void Rewind(const uint64_t numLeaves) final;
 
@@ -1,15 +1,27 @@
 #pragma once
 
 #include <mw/common/BitSet.h>
+#include <mw/models/crypto/Hash.h>
 #include <mw/mmr/Index.h>
+#include <mw/mmr/Leaf.h>
 #include <mw/mmr/LeafIndex.h>
+#include <span.h>
 
 class IMMR;
 
 class MMRUtil
 {
 public:
-    static mw::Hash CalcParentHash(const mmr::Index& index, const mw::Hash& left_hash, const mw::Hash& right_hash);
+    static mw::Hash CalcParentHash(const mmr::Index& index, const mw::HashView& left_hash, const mw::HashView& right_hash);
+
+    /// <summary>
+    /// Calculates the hashes of all nodes (leaves and parents) added by appending the given leaves to the MMR.
+    /// Parents are hashed one height at a time, so each height takes a single multi-input BLAKE3 call.
+    /// </summary>
+    /// <param name="mmr">The MMR being appended to.</param>
+    /// <param name="leaves">Consecutive leaves, starting at the MMR's next leaf index.</param>
+    /// <returns>The hashes of the new nodes, in position order.</returns>
+    static std::vector<mw::Hash> CalcAppendedHashes(const IMMR& mmr, const Span<const mmr::Leaf>& leaves);
     static std::vector<mmr::Index> CalcPeakIndices(const uint64_t num_nodes);
     static boost::optional<mw::Hash> CalcBaggedPeak(const IMMR& mmr, const mmr::Index& peak_idx);
 
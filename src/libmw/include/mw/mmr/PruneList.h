@@ -17,15 +17,14 @@ public:
 
     uint64_t GetShift(const mmr::Index& index) const noexcept;
     uint64_t GetShift(const mmr::LeafIndex& index) const noexcept;
-    uint64_t GetTotalShift() const noexcept { return m_totalShift; }
+    uint64_t GetTotalShift() const noexcept { return m_compacted.count(); }
 
     void Commit(const uint32_t file_index, const BitSet& compacted);
 
 private:
-    PruneList(const FilePath& dir, BitSet&& compacted, uint64_t total_shift)
-        : m_dir(dir), m_compacted(std::move(compacted)), m_totalShift(total_shift) { }
+    PruneList(const FilePath& dir, const BitSet& compacted)
+        : m_dir(dir), m_compacted(compacted) { }
 
     FilePath m_dir;
-    BitSet m_compacted;
-    uint64_t m_totalShift;
+    RankIndexedBitSet m_compacted;
 };
\ No newline at end of file
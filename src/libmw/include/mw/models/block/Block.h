@@ -75,6 +75,12 @@ public:
     //
     void Validate() const;
 
+    //
+    // Context-free validation of the block, excluding signatures, rangeproofs, and the stealth sum.
+    // Those checks are independent of each other, so callers may run them concurrently instead.
+    //
+    void ValidateStructure() const;
+
 private:
     mw::Header::CPtr m_pHeader;
     TxBody m_body;
@@ -8,11 +8,42 @@
 #include <mw/common/Traits.h>
 #include <mw/models/crypto/BigInteger.h>
 #include <boost/functional/hash.hpp>
+#include <cstring>
 
 MW_NAMESPACE
 
 using Hash = BigInt<32>;
 
+/// <summary>
+/// A non-owning view of a 32-byte hash, such as one stored in a memory-mapped MMR hash file.
+/// mw::Hash always owns a heap-allocated buffer, so reading hashes through views lets hot loops
+/// avoid the allocator. A view is only valid for as long as the memory it points to.
+/// </summary>
+class HashView
+{
+public:
+    explicit HashView(const uint8_t* data) noexcept : m_data(data) { }
+    HashView(const Hash& hash) noexcept : m_data(hash.data()) { }
+
+    static size_t size() noexcept { return Hash::size(); }
+    const uint8_t* data() const noexcept { return m_data; }
+
+    Hash ToHash() const { return Hash(m_data); }
+
+    bool operator==(const HashView& rhs) const noexcept { return std::memcmp(m_data, rhs.m_data, size()) == 0; }
+    bool operator!=(const HashView& rhs) const noexcept { return !(*this == rhs); }
+
+    // Serializes the same as mw::Hash.
+    template <typename Stream>
+    void Serialize(Stream& s) const
+    {
+        s.write((const char*)m_data, size());
+    }
+
+private:
+    const uint8_t* m_data;
+};
+
 END_NAMESPACE
 
 namespace std
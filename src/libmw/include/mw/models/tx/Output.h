@@ -174,6 +174,28 @@ public:
     SignedMessage BuildSignedMsg() const noexcept;
     ProofData BuildProofData() const noexcept;
 
+    //
+    // Computes the ID of an output with the given fields.
+    // Only the hash of the rangeproof is needed, so IDs can be recomputed for outputs stored without their proof.
+    //
+    static mw::Hash CalcOutputID(
+        const Commitment& commitment,
+        const PublicKey& senderPubKey,
+        const PublicKey& receiverPubKey,
+        const OutputMessage& message,
+        const mw::Hash& proofHash,
+        const Signature& signature) noexcept
+    {
+        return Hasher()
+            .Append(commitment)
+            .Append(senderPubKey)
+            .Append(receiverPubKey)
+            .Append(message.GetHash())
+            .Append(proofHash)
+            .Append(signature)
+            .hash();
+    }
+
     //
     // Serialization/Deserialization
     //
@@ -203,14 +225,7 @@ private:
     //
     mw::Hash ComputeHash() const noexcept
     {
-        return Hasher()
-            .Append(m_commitment)
-            .Append(m_senderPubKey)
-            .Append(m_receiverPubKey)
-            .Append(m_message.GetHash())
-            .Append(m_pProof->GetHash())
-            .Append(m_signature)
-            .hash();
+        return CalcOutputID(m_commitment, m_senderPubKey, m_receiverPubKey, m_message, m_pProof->GetHash(), m_signature);
     }
 
     Commitment m_commitment;
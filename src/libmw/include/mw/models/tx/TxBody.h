@@ -102,6 +102,19 @@ public:
         READWRITE(obj.m_inputs, obj.m_outputs, obj.m_kernels);
     }
 
+    //
+    // Verifies the weight, sorting, and uniqueness of the inputs, outputs, and kernels.
+    // This covers everything Validate() checks except for signatures and rangeproofs.
+    //
+    void ValidateStructure() const;
+
+    //
+    // The kernel, input, and output signatures and output rangeproofs to verify.
+    // These can be verified in independent batches.
+    //
+    std::vector<SignedMessage> BuildSignedMsgs() const;
+    std::vector<ProofData> BuildProofData() const;
+
     void Validate() const;
 
 private:
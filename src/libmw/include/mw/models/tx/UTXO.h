@@ -5,42 +5,248 @@
 #include <mw/models/tx/Output.h>
 #include <mw/mmr/LeafIndex.h>
 #include <serialize.h>
+#include <boost/optional.hpp>
+#include <stdexcept>
 
 class UTXO : public Traits::ISerializable
 {
 public:
     using CPtr = std::shared_ptr<const UTXO>;
 
-    UTXO() : m_blockHeight(0), m_leafIdx(), m_output() { }
-    UTXO(const int32_t blockHeight, mmr::LeafIndex leafIdx, Output output)
-        : m_blockHeight(blockHeight), m_leafIdx(std::move(leafIdx)), m_output(std::move(output)) { }
+    UTXO() : m_blockHeight(0), m_leafIdx() { }
+    UTXO(const int32_t blockHeight, mmr::LeafIndex leafIdx, const Output& output)
+        : m_blockHeight(blockHeight),
+        m_leafIdx(std::move(leafIdx)),
+        m_commitment(output.GetCommitment()),
+        m_senderPubKey(output.GetSenderPubKey()),
+        m_receiverPubKey(output.GetReceiverPubKey()),
+        m_message(output.GetOutputMessage()),
+        m_proofHash(output.GetRangeProof()->GetHash()),
+        m_pProof(output.GetRangeProof()),
+        m_signature(output.GetSignature()),
+        m_outputID(output.GetOutputID()) { }
+    UTXO(
+        const int32_t blockHeight,
+        mmr::LeafIndex leafIdx,
+        Commitment commitment,
+        PublicKey senderPubKey,
+        PublicKey receiverPubKey,
+        OutputMessage message,
+        mw::Hash proofHash,
+        Signature signature
+    ) : m_blockHeight(blockHeight),
+        m_leafIdx(std::move(leafIdx)),
+        m_commitment(std::move(commitment)),
+        m_senderPubKey(std::move(senderPubKey)),
+        m_receiverPubKey(std::move(receiverPubKey)),
+        m_message(std::move(message)),
+        m_proofHash(std::move(proofHash)),
+        m_pProof(nullptr),
+        m_signature(std::move(signature))
+    {
+        m_outputID = Output::CalcOutputID(m_commitment, m_senderPubKey, m_receiverPubKey, m_message, m_proofHash, m_signature);
+    }
+
+    /// <summary>
+    /// Same as above, but with an output ID that's already known (e.g. the key the UTXO was stored under),
+    /// which saves hashing the output. The caller is responsible for it matching the other fields.
+    /// </summary>
+    UTXO(
+        const int32_t blockHeight,
+        mmr::LeafIndex leafIdx,
+        Commitment commitment,
+        PublicKey senderPubKey,
+        PublicKey receiverPubKey,
+        OutputMessage message,
+        mw::Hash proofHash,
+        Signature signature,
+        mw::Hash outputID
+    ) : m_blockHeight(blockHeight),
+        m_leafIdx(std::move(leafIdx)),
+        m_commitment(std::move(commitment)),
+        m_senderPubKey(std::move(senderPubKey)),
+        m_receiverPubKey(std::move(receiverPubKey)),
+        m_message(std::move(message)),
+        m_proofHash(std::move(proofHash)),
+        m_pProof(nullptr),
+        m_signature(std::move(signature)),
+        m_outputID(std::move(outputID)) { }
 
     int32_t GetBlockHeight() const noexcept { return m_blockHeight; }
     const mmr::LeafIndex& GetLeafIndex() const noexcept { return m_leafIdx; }
-    const Output& GetOutput() const noexcept { return m_output; }
-
-    const mw::Hash& GetOutputID() const noexcept { return m_output.GetOutputID(); }
-    const Commitment& GetCommitment() const noexcept { return m_output.GetCommitment(); }
-    const PublicKey& GetSenderPubKey() const noexcept { return m_output.GetSenderPubKey(); }
-    const PublicKey& GetReceiverPubKey() const noexcept { return m_output.GetReceiverPubKey(); }
-    const OutputMessage& GetOutputMessage() const noexcept { return m_output.GetOutputMessage(); }
-    const RangeProof::CPtr& GetRangeProof() const noexcept { return m_output.GetRangeProof(); }
-    const Signature& GetSignature() const noexcept { return m_output.GetSignature(); }
-    ProofData BuildProofData() const noexcept { return m_output.BuildProofData(); }
-
-    IMPL_SERIALIZABLE(UTXO, obj)
+
+    const mw::Hash& GetOutputID() const noexcept { return m_outputID; }
+    const Commitment& GetCommitment() const noexcept { return m_commitment; }
+    const PublicKey& GetSenderPubKey() const noexcept { return m_senderPubKey; }
+    const PublicKey& GetReceiverPubKey() const noexcept { return m_receiverPubKey; }
+    const OutputMessage& GetOutputMessage() const noexcept { return m_message; }
+    const mw::Hash& GetRangeProofHash() const noexcept { return m_proofHash; }
+    const Signature& GetSignature() const noexcept { return m_signature; }
+
+    /// <summary>
+    /// The coins database stores rangeproofs separately from the UTXOs, since spend validation never needs them.
+    /// UTXOs read from it don't carry their rangeproof until it's attached with WithRangeProof.
+    /// </summary>
+    /// <returns>The rangeproof, or nullptr if it hasn't been loaded.</returns>
+    const RangeProof::CPtr& GetRangeProof() const noexcept { return m_pProof; }
+    bool HasRangeProof() const noexcept { return m_pProof != nullptr; }
+
+    /// <summary>
+    /// Returns a copy of the UTXO carrying the given rangeproof.
+    /// </summary>
+    /// <throws>std::invalid_argument if the rangeproof doesn't match the one the output committed to.</throws>
+    UTXO WithRangeProof(const RangeProof::CPtr& pProof) const
     {
-        READWRITE(obj.m_blockHeight, obj.m_leafIdx, obj.m_output);
+        if (pProof == nullptr || pProof->GetHash() != m_proofHash) {
+            throw std::invalid_argument("Rangeproof doesn't belong to MWEB UTXO " + m_outputID.ToHex());
+        }
+
+        UTXO utxo(*this);
+        utxo.m_pProof = pProof;
+        return utxo;
+    }
+
+    /// <summary>
+    /// Rebuilds the full output. The rangeproof must have been loaded.
+    /// </summary>
+    /// <throws>std::ios_base::failure if the UTXO doesn't carry its rangeproof.</throws>
+    Output GetOutput() const
+    {
+        if (m_pProof == nullptr) {
+            throw std::ios_base::failure("Rangeproof not loaded for MWEB UTXO " + m_outputID.ToHex());
+        }
+
+        return Output(m_commitment, m_senderPubKey, m_receiverPubKey, m_message, m_pProof, m_signature);
+    }
+
+    ProofData BuildProofData() const { return GetOutput().BuildProofData(); }
+
+    //
+    // Serializes the UTXO along with its full output, including the rangeproof.
+    // This is the format of the MWEB undo data, so it must stay compatible with existing blocks' undo files.
+    //
+    IMPL_SERIALIZED(UTXO);
+
+    template <typename Stream>
+    void Serialize(Stream& s) const
+    {
+        s << m_blockHeight << m_leafIdx << GetOutput();
+    }
+
+    template <typename Stream>
+    void Unserialize(Stream& s)
+    {
+        int32_t blockHeight;
+        mmr::LeafIndex leafIdx;
+        Output output;
+        s >> blockHeight >> leafIdx >> output;
+        *this = UTXO(blockHeight, std::move(leafIdx), output);
     }
 
 private:
     int32_t m_blockHeight;
     mmr::LeafIndex m_leafIdx;
-    Output m_output;
+    Commitment m_commitment;
+    PublicKey m_senderPubKey;
+    PublicKey m_receiverPubKey;
+    OutputMessage m_message;
+    mw::Hash m_proofHash;
+    RangeProof::CPtr m_pProof;
+    Signature m_signature;
+
+    mw::Hash m_outputID;
+};
+
+/// <summary>
+/// Serializes a UTXO without its rangeproof, which is committed to by its hash instead.
+/// This is the format UTXOs are stored in by the coins database, saving ~675 bytes per coin.
+/// </summary>
+class CompactUTXO : public Traits::ISerializable
+{
+public:
+    CompactUTXO() = default;
+    CompactUTXO(const UTXO::CPtr& pUTXO)
+        : m_pUTXO(pUTXO) { }
+
+    /// <summary>
+    /// Creates an empty CompactUTXO to deserialize the coin stored under the given coins database key into.
+    /// The key is the raw output ID, so it's used as is instead of being recomputed from the deserialized output.
+    /// </summary>
+    static CompactUTXO FromDBKey(const std::string& key)
+    {
+        CompactUTXO compact;
+        if (key.size() == mw::Hash::size()) {
+            compact.m_outputID = mw::Hash((const uint8_t*)key.data());
+        }
+
+        return compact;
+    }
+
+    const UTXO::CPtr& GetUTXO() const noexcept { return m_pUTXO; }
+
+    IMPL_SERIALIZED(CompactUTXO);
+
+    template <typename Stream>
+    void Serialize(Stream& s) const
+    {
+        s << m_pUTXO->GetBlockHeight();
+        s << m_pUTXO->GetLeafIndex();
+        s << m_pUTXO->GetCommitment();
+        s << m_pUTXO->GetSenderPubKey();
+        s << m_pUTXO->GetReceiverPubKey();
+        s << m_pUTXO->GetOutputMessage();
+        s << m_pUTXO->GetRangeProofHash();
+        s << m_pUTXO->GetSignature();
+    }
+
+    template <typename Stream>
+    void Unserialize(Stream& s)
+    {
+        int32_t blockHeight;
+        mmr::LeafIndex leafIdx;
+        Commitment commitment;
+        PublicKey senderPubKey;
+        PublicKey receiverPubKey;
+        OutputMessage message;
+        mw::Hash proofHash;
+        Signature signature;
+        s >> blockHeight >> leafIdx >> commitment >> senderPubKey >> receiverPubKey >> message >> proofHash >> signature;
+
+        if (m_outputID) {
+            m_pUTXO = std::make_shared<UTXO>(
+                blockHeight,
+                std::move(leafIdx),
+                std::move(commitment),
+                std::move(senderPubKey),
+                std::move(receiverPubKey),
+                std::move(message),
+                std::move(proofHash),
+                std::move(signature),
+                *m_outputID
+            );
+            return;
+        }
+
+        m_pUTXO = std::make_shared<UTXO>(
+            blockHeight,
+            std::move(leafIdx),
+            std::move(commitment),
+            std::move(senderPubKey),
+            std::move(receiverPubKey),
+            std::move(message),
+            std::move(proofHash),
+            std::move(signature)
+        );
+    }
+
+private:
+    UTXO::CPtr m_pUTXO;
+    boost::optional<mw::Hash> m_outputID;
 };
 
 /// <summary>
 /// MWEB UTXO wrapper that supports serialization into multiple formats.
+/// The FULL_UTXO format requires the UTXO's rangeproof to be loaded.
 /// </summary>
 class NetUTXO
 {
@@ -67,7 +273,7 @@ public:
             s << m_utxo->GetSenderPubKey();
             s << m_utxo->GetReceiverPubKey();
             s << m_utxo->GetOutputMessage();
-            s << m_utxo->GetRangeProof()->GetHash();
+            s << m_utxo->GetRangeProofHash();
             s << m_utxo->GetSignature();
         } else {
             throw std::ios_base::failure("Unsupported MWEB UTXO serialization format");
@@ -22,7 +22,15 @@ public:
     BlockBuilder(const uint64_t height, const mw::ICoinsView::Ptr& pCoinsView)
         : m_height(height), m_weight(0), m_pCoinsView(std::make_shared<mw::CoinsViewCache>(pCoinsView)) { }
 
-    bool AddTransaction(const Transaction::CPtr& pTransaction, const std::vector<PegInCoin>& pegins);
+    /// <summary>
+    /// Stages a transaction for inclusion in the block, after checking its pegins, weight, inputs, and outputs.
+    /// </summary>
+    /// <param name="pTransaction">The transaction to add. Must not be null.</param>
+    /// <param name="pegins">The pegins the transaction's canonical outputs commit to.</param>
+    /// <param name="validated">True if the transaction was already validated, e.g. when it was accepted to the mempool.
+    /// Its signatures, rangeproofs, and kernel sums are then not verified again.</param>
+    /// <returns>True if the transaction was added.</returns>
+    bool AddTransaction(const Transaction::CPtr& pTransaction, const std::vector<PegInCoin>& pegins, const bool validated = false);
 
     mw::Block::Ptr BuildBlock() const;
 
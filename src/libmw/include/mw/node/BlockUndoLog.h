@@ -0,0 +1,81 @@
+#pragma once
+
+#include <mw/common/Macros.h>
+#include <mw/models/block/BlockUndo.h>
+#include <mw/models/crypto/Hash.h>
+#include <mw/node/CoinsView.h>
+#include <deque>
+#include <functional>
+#include <unordered_map>
+
+MW_NAMESPACE
+
+/// <summary>
+/// A bounded, in-memory log of the MWEB undo data of the most recently connected blocks.
+/// Each entry is the reverse delta (spent coins, added coins, and previous header) needed
+/// to turn the state after a block into the state before it, so the UTXO set, leafset,
+/// and output PMMR of any recent block can be rebuilt in memory from the chain tip,
+/// without reading blocks from disk or disconnecting anything from the chainstate.
+/// </summary>
+class BlockUndoLog
+{
+public:
+    /// <summary>
+    /// Reads the persisted undo data of the block with the given MWEB header, or returns nullptr if it isn't available.
+    /// </summary>
+    using ReadUndoFn = std::function<mw::BlockUndo::CPtr(const mw::Hash& header_hash)>;
+
+    /// <summary>
+    /// Constructs an empty log.
+    /// </summary>
+    /// <param name="max_blocks">The maximum number of blocks to keep undo data for.</param>
+    explicit BlockUndoLog(const size_t max_blocks)
+        : m_maxBlocks(max_blocks) { }
+
+    /// <summary>
+    /// Records the undo data of a newly connected block, evicting the oldest entry once the log is full.
+    /// Entries for blocks that are later disconnected are harmless, since snapshots are only built by
+    /// following the previous header hashes back from the chain tip.
+    /// </summary>
+    /// <param name="header_hash">The hash of the MWEB header of the connected block.</param>
+    /// <param name="pUndo">The MWEB undo data produced when connecting the block. Must not be null.</param>
+    void Add(const mw::Hash& header_hash, const mw::BlockUndo::CPtr& pUndo);
+
+    /// <summary>
+    /// Removes all entries.
+    /// </summary>
+    void Clear() noexcept;
+
+    size_t Size() const noexcept { return m_undos.size(); }
+
+    /// <summary>
+    /// Builds an in-memory view of the MWEB state as of the block with the given MWEB header,
+    /// by applying the logged reverse deltas on top of the given view of the chain tip.
+    /// Undo data missing from the log, e.g. for blocks connected before a restart, is read using read_undo
+    /// and added to the log. The most recent snapshot is kept until the log or the tip view changes,
+    /// so repeated requests for the same block don't undo the blocks again.
+    /// The tip view is only read from, never modified.
+    /// </summary>
+    /// <param name="pTip">The view of the active chain tip. Must not be null.</param>
+    /// <param name="header_hash">The hash of the MWEB header of the requested block.</param>
+    /// <param name="read_undo">Reads the persisted undo data of blocks missing from the log. May be null.</param>
+    /// <returns>The rebuilt view, or nullptr if the undo data doesn't reach back to the requested block.</returns>
+    /// <throws>ValidationException if the rebuilt MMRs don't match the requested header.</throws>
+    mw::CoinsViewCache::Ptr Snapshot(
+        const mw::ICoinsView::Ptr& pTip,
+        const mw::Hash& header_hash,
+        const ReadUndoFn& read_undo = nullptr
+    );
+
+private:
+    size_t m_maxBlocks;
+    std::deque<mw::Hash> m_order;
+    std::unordered_map<mw::Hash, mw::BlockUndo::CPtr> m_undos;
+
+    mw::ICoinsView::Ptr m_pSnapshotTip;
+    mw::Hash m_snapshotTipHash;
+    mw::Hash m_snapshotHash;
+    mw::CoinsViewCache::Ptr m_pSnapshot;
+};
+
+END_NAMESPACE // mw
\ No newline at end of file
@@ -1,10 +1,54 @@
 #pragma once
 
 #include <mw/models/block/Block.h>
+#include <mw/models/crypto/BlindingFactor.h>
+#include <mw/models/crypto/ProofData.h>
+#include <mw/models/crypto/SignedMessage.h>
 
 class BlockValidator
 {
 public:
+    /// <summary>
+    /// One independent part of a block's validation: a batch of signatures or rangeproofs, the stealth sum, or the kernel sum.
+    /// Checks don't depend on each other or on the chain state, so they can be run concurrently (e.g. on the script check threads).
+    /// </summary>
+    class Check
+    {
+    public:
+        Check() = default;
+
+        static Check Signatures(std::vector<SignedMessage>&& batch);
+        static Check RangeProofs(std::vector<ProofData>&& batch);
+        static Check StealthSum(const mw::Block::CPtr& pBlock);
+        static Check KernelSum(const mw::Block::CPtr& pBlock, const BlindingFactor& prev_kernel_offset);
+
+        bool IsNull() const noexcept { return m_type == Type::NONE; }
+
+        /// <summary>
+        /// Runs the check, logging the reason it failed, if any.
+        /// </summary>
+        /// <returns>true if the check passed.</returns>
+        bool operator()() const noexcept;
+
+        void swap(Check& other) noexcept
+        {
+            std::swap(m_type, other.m_type);
+            m_signatures.swap(other.m_signatures);
+            m_proofs.swap(other.m_proofs);
+            m_pBlock.swap(other.m_pBlock);
+            std::swap(m_prevKernelOffset, other.m_prevKernelOffset);
+        }
+
+    private:
+        enum class Type { NONE, SIGNATURES, RANGEPROOFS, STEALTH_SUM, KERNEL_SUM };
+
+        Type m_type{Type::NONE};
+        std::vector<SignedMessage> m_signatures;
+        std::vector<ProofData> m_proofs;
+        mw::Block::CPtr m_pBlock;
+        BlindingFactor m_prevKernelOffset;
+    };
+
     BlockValidator() = default;
 
     static bool ValidateBlock(
@@ -13,6 +57,29 @@ public:
         const std::vector<PegOutCoin>& pegOutCoins
     ) noexcept;
 
+    /// <summary>
+    /// Same as ValidateBlock, except the signatures, rangeproofs, and stealth sum are not verified.
+    /// Those are left to the checks built by BuildChecks, which must all pass for the block to be valid.
+    /// </summary>
+    static bool ValidateStructure(
+        const mw::Block::CPtr& pBlock,
+        const std::vector<PegInCoin>& pegInCoins,
+        const std::vector<PegOutCoin>& pegOutCoins
+    ) noexcept;
+
+    /// <summary>
+    /// Splits the verification of the block's signatures, rangeproofs, stealth sum, and kernel sum into independent checks.
+    /// </summary>
+    /// <param name="pBlock">The block, whose structure was already validated by ValidateStructure.</param>
+    /// <param name="prev_kernel_offset">The total kernel offset of the previous block's header.</param>
+    /// <param name="num_batches">The max number of batches to split the signatures, and the rangeproofs, into.</param>
+    /// <returns>The checks, which must all pass for the block to be valid.</returns>
+    static std::vector<Check> BuildChecks(
+        const mw::Block::CPtr& pBlock,
+        const BlindingFactor& prev_kernel_offset,
+        const size_t num_batches
+    );
+
 private:
     static void ValidatePegInCoins(
         const mw::Block::CPtr& pBlock,
@@ -58,6 +58,22 @@ public:
     /// <returns>True if there's a matching unspent coin. Otherwise, false.</returns>
     bool HasCoin(const mw::Hash& output_id) const noexcept { return GetUTXO(output_id) != nullptr; }
 
+    /// <summary>
+    /// Looks up an unspent coin along with its rangeproof.
+    /// GetUTXO leaves the rangeproof out for coins read from the database, so this should only be used
+    /// when the full output is needed, like when serving it to peers or building undo data.
+    /// </summary>
+    /// <param name="output_id">The output ID of the UTXO to look for.</param>
+    /// <returns>The UTXO, with its rangeproof loaded. nullptr if not found.</returns>
+    /// <throws>DatabaseException if the rangeproof is missing from the database.</throws>
+    UTXO::CPtr GetUTXOWithProof(const mw::Hash& output_id) const;
+
+    /// <summary>
+    /// Reads the UTXO's rangeproof from the database, if the UTXO doesn't already carry it.
+    /// </summary>
+    /// <throws>DatabaseException if the rangeproof is missing from the database.</throws>
+    UTXO LoadRangeProof(const UTXO& utxo) const;
+
     /// <summary>
     /// Checks if there's a unspent coin with a matching commitment in the view that has not been flushed to the parent.
     /// This is useful for checking if a coin is in the mempool but not yet on chain.
@@ -94,8 +110,9 @@ public:
     /// </summary>
     /// <pre>Block must be validated via CheckBlock before connecting it to the chain.</pre>
     /// <param name="pBlock">The block to connect. Must not be null.</param>
+    /// <param name="check_kernel_sum">False if the kernel sum was already verified, e.g. by a BlockValidator::Check.</param>
     /// <throws>ValidationException if consensus rules are not met.</throws>
-    mw::BlockUndo::CPtr ApplyBlock(const mw::Block::CPtr& pBlock);
+    mw::BlockUndo::CPtr ApplyBlock(const mw::Block::CPtr& pBlock, const bool check_kernel_sum = true);
 
     void AddTx(const mw::Transaction::CPtr& pTx);
 
@@ -129,6 +146,12 @@ public:
 
 private:
     void AddUTXO(const uint64_t header_height, const Output& output);
+
+    /// <summary>
+    /// Adds the outputs of a block to the UTXO set, appending them to the output PMMR in one batch.
+    /// </summary>
+    /// <throws>ValidationException if any of the outputs is already unspent, or appears twice.</throws>
+    void AddUTXOs(const uint64_t header_height, const std::vector<Output>& outputs);
     UTXO SpendUTXO(const mw::Hash& output_id);
 
     ICoinsView::Ptr m_pBase;
@@ -177,7 +200,6 @@ private:
 
     void AddUTXO(CoinDB& coinDB, const Output& output);
     void AddUTXO(CoinDB& coinDB, const UTXO::CPtr& pUTXO);
-    void SpendUTXO(CoinDB& coinDB, const mw::Hash& output_id);
     UTXO::CPtr GetUTXO(const CoinDB& coinDB, const mw::Hash& output_id) const;
 
     LeafSet::Ptr m_pLeafSet;
@@ -5,6 +5,7 @@
 #include <mw/models/wallet/Coin.h>
 #include <mw/models/wallet/StealthAddress.h>
 #include <memory>
+#include <vector>
 
 // Forward Declarations
 class LegacyScriptPubKeyMan;
@@ -28,6 +29,14 @@ public:
     // used to calculate the spend key when the wallet becomes unlocked.
     bool RewindOutput(const Output& output, mw::Coin& coin) const;
 
+    // Calculates the shared secret (Ke*a) for the output, returning false if the output's view tag doesn't match it.
+    // This is the only part of the rewind that needs to run for every output, so it's split out to let
+    // callers check a batch of outputs in parallel. Throws if the output's Ke is not a valid public key.
+    bool CheckViewTag(const Output& output, PublicKey& shared_secret) const;
+
+    // Rewinds an output whose view tag has already been checked against the given shared secret.
+    bool RewindOutput(const Output& output, const PublicKey& shared_secret, mw::Coin& coin) const;
+
     // Calculates the output secret key for the given coin.
     // If the address index is known, it calculates from the keychain's master spend key.
     // If not, it attempts to lookup the spend key in the database.
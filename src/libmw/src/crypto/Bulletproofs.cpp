@@ -1,8 +1,9 @@
 #include <mw/crypto/Bulletproofs.h>
 #include "Context.h"
 #include "ConversionUtil.h"
+#include "ScratchSpace.h"
 
-#include <caches/Cache.h>
+#include <mw/crypto/VerificationCache.h>
 #include <mw/exceptions/CryptoException.h>
 #include <mw/util/VectorUtil.h>
 
@@ -11,9 +12,23 @@ static constexpr size_t SCRATCH_SPACE_SIZE = 256 * MAX_WIDTH;
 static constexpr size_t PROOF_LEN = 675;
 static constexpr size_t NUM_BITS_PROVEN = 64;
 
-static Locked<LRUCache<Commitment, ProofData>> CACHE(std::make_shared<LRUCache<Commitment, ProofData>>(3000));
+static VerificationCache CACHE;
 static Locked<Context> BP_CONTEXT(std::make_shared<Context>());
 
+// Each thread reuses its own scratch space, rather than creating one for every batch or proof.
+static thread_local std::unique_ptr<ScratchSpace> THREAD_SCRATCH;
+
+static uint256 ComputeCacheEntry(const ProofData& proof)
+{
+    uint256 entry;
+    CACHE.GetSaltedHasher()
+        .Write(proof.commitment.data(), proof.commitment.size())
+        .Write(proof.pRangeProof->data(), proof.pRangeProof->size())
+        .Write(proof.extraData.data(), proof.extraData.size())
+        .Finalize(entry.begin());
+    return entry;
+}
+
 bool Bulletproofs::BatchVerify(const std::vector<ProofData>& proofs)
 {
     std::vector<secp256k1_pedersen_commitment> secpCommitments;
@@ -28,10 +43,14 @@ bool Bulletproofs::BatchVerify(const std::vector<ProofData>& proofs)
     std::vector<size_t> extraDataLen;
     extraDataLen.reserve(proofs.size());
 
+    std::vector<uint256> unverified_entries;
+    unverified_entries.reserve(proofs.size());
+
     for (const auto& proof : proofs)
     {
-        auto cache_writer = CACHE.Write();
-        if (!cache_writer->Cached(proof.commitment) || proof != cache_writer->Get(proof.commitment)) {
+        uint256 cache_entry = ComputeCacheEntry(proof);
+        if (!CACHE.Contains(cache_entry, false)) {
+            unverified_entries.push_back(std::move(cache_entry));
             secpCommitments.push_back(ConversionUtil::ToSecp256k1(proof.commitment));
             bulletproofPointers.emplace_back(proof.pRangeProof->data());
 
@@ -50,22 +69,17 @@ bool Bulletproofs::BatchVerify(const std::vector<ProofData>& proofs)
     }
 
     // array of generator multiplied by value in pedersen commitments (cannot be NULL)
-    std::vector<secp256k1_generator> valueGenerators;
-    for (size_t i = 0; i < secpCommitments.size(); i++)
-    {
-        valueGenerators.push_back(secp256k1_generator_const_h);
-    }
+    std::vector<secp256k1_generator> valueGenerators(secpCommitments.size(), secp256k1_generator_const_h);
 
     std::vector<secp256k1_pedersen_commitment*> commitmentPointers = VectorUtil::ToPointerVec(secpCommitments);
 
-    secp256k1_scratch_space* pScratchSpace = secp256k1_scratch_space_create(
-        BP_CONTEXT.Read()->Get(),
-        SCRATCH_SPACE_SIZE
-    );
+    // Hold a single read lock for the context and its generators, rather than re-locking for each argument.
+    auto context_reader = BP_CONTEXT.Read();
+    ScratchSpaceLease scratch(THREAD_SCRATCH, context_reader->Get(), SCRATCH_SPACE_SIZE);
     const int result = secp256k1_bulletproof_rangeproof_verify_multi(
-        BP_CONTEXT.Read()->Get(),
-        pScratchSpace,
-        BP_CONTEXT.Read()->GetGenerators(),
+        context_reader->Get(),
+        scratch.Get(),
+        context_reader->GetGenerators(),
         bulletproofPointers.data(),
         secpCommitments.size(),
         PROOF_LEN,
@@ -77,19 +91,28 @@ bool Bulletproofs::BatchVerify(const std::vector<ProofData>& proofs)
         extraData.data(),
         extraDataLen.data()
     );
-    secp256k1_scratch_space_destroy(pScratchSpace);
 
     if (result == 1) {
-        auto cache_writer = CACHE.Write();
-        for (const auto& proof : proofs)
+        scratch.SetSucceeded();
+        for (const uint256& cache_entry : unverified_entries)
         {
-            cache_writer->Put(proof.commitment, proof);
+            CACHE.Insert(cache_entry);
         }
     }
 
     return result == 1;
 }
 
+size_t Bulletproofs::InitCache(const uint256& nonce, const size_t max_bytes)
+{
+    return CACHE.Setup(nonce, max_bytes);
+}
+
+VerificationCache::Stats Bulletproofs::GetCacheStats()
+{
+    return CACHE.GetStats();
+}
+
 RangeProof::CPtr Bulletproofs::Generate(
     const uint64_t amount,
     const SecretKey& key,
@@ -104,12 +127,11 @@ RangeProof::CPtr Bulletproofs::Generate(
     std::vector<uint8_t> proofBytes(RangeProof::SIZE, 0);
     size_t proofLen = RangeProof::SIZE;
 
-    secp256k1_scratch_space* pScratchSpace = secp256k1_scratch_space_create(pContext, SCRATCH_SPACE_SIZE);
-
     std::vector<const uint8_t*> blindingFactors({ key.data() });
+    ScratchSpaceLease scratch(THREAD_SCRATCH, pContext, SCRATCH_SPACE_SIZE);
     int result = secp256k1_bulletproof_rangeproof_prove(
         pContext,
-        pScratchSpace,
+        scratch.Get(),
         contextWriter->GetGenerators(),
         &proofBytes[0],
         &proofLen,
@@ -129,12 +151,12 @@ RangeProof::CPtr Bulletproofs::Generate(
         extraData.size(),
         proofMessage.data()
     );
-    secp256k1_scratch_space_destroy(pScratchSpace);
 
     if (result != 1) {
         ThrowCrypto_F("secp256k1_bulletproof_rangeproof_prove failed with error: {}", result);
     }
 
+    scratch.SetSucceeded();
     proofBytes.resize(proofLen);
     return std::make_shared<RangeProof>(std::move(proofBytes));
 }
@@ -1,9 +1,33 @@
+#if defined(HAVE_CONFIG_H)
+#include <config/bitcoin-config.h>
+#endif
+
 #include <mw/crypto/Hasher.h>
 
+// blake3_dispatch picks the fastest kernel the CPU supports at runtime.
+// The SSE4.1, AVX2 and AVX-512 kernels need their own compiler flags,
+// so they're built into the matching libbitcoin_crypto_* libraries (see crypto/blake3_*.cpp).
+// SSE2 is part of the x86_64 baseline, so that kernel is always built there.
+#if !defined(USE_ASM) || defined(BUILD_BITCOIN_INTERNAL)
+#define BLAKE3_NO_AVX512 1
+#define BLAKE3_NO_AVX2 1
+#define BLAKE3_NO_SSE41 1
+#define BLAKE3_NO_SSE2 1
+#else
+#if !defined(ENABLE_AVX512)
 #define BLAKE3_NO_AVX512 1
+#endif
+#if !defined(ENABLE_AVX2)
 #define BLAKE3_NO_AVX2 1
+#endif
+#if !defined(ENABLE_SSE41)
 #define BLAKE3_NO_SSE41 1
+#endif
+#if !defined(__x86_64__) && !defined(_M_X64)
 #define BLAKE3_NO_SSE2 1
+#endif
+#endif
+
 extern "C" {
 #include <crypto/blake3/blake3.c>
 #include <crypto/blake3/blake3_dispatch.c>
@@ -20,4 +44,80 @@ mw::Hash Hashed(const std::vector<uint8_t>& serialized)
 mw::Hash Hashed(const Traits::ISerializable& serializable)
 {
     return Hashed(serializable.Serialized());
+}
+
+std::vector<mw::Hash> HashedMany(const std::vector<const uint8_t*>& inputs, const size_t len)
+{
+    assert(len > 0 && len <= BLAKE3_CHUNK_LEN);
+
+    // Each message is a single chunk. All blocks but the last are compressed for every message at once
+    // by the multi-input kernel. The last block, which may be partial and carries the CHUNK_END and ROOT flags,
+    // is then compressed for each message separately.
+    const size_t num_full_blocks = (len - 1) / BLAKE3_BLOCK_LEN;
+    const size_t last_block_len = len - (num_full_blocks * BLAKE3_BLOCK_LEN);
+
+    std::vector<uint8_t> cvs(inputs.size() * BLAKE3_OUT_LEN);
+    if (num_full_blocks > 0 && !inputs.empty()) {
+        blake3_hash_many(inputs.data(), inputs.size(), num_full_blocks, IV, 0, false, 0, CHUNK_START, 0, cvs.data());
+    }
+
+    std::vector<mw::Hash> hashes(inputs.size());
+    for (size_t i = 0; i < inputs.size(); i++) {
+        uint32_t cv[8];
+        if (num_full_blocks > 0) {
+            for (size_t w = 0; w < 8; w++) {
+                cv[w] = load32(&cvs[(i * BLAKE3_OUT_LEN) + (w * 4)]);
+            }
+        } else {
+            memcpy(cv, IV, BLAKE3_KEY_LEN);
+        }
+
+        uint8_t block[BLAKE3_BLOCK_LEN] = {0};
+        memcpy(block, inputs[i] + (num_full_blocks * BLAKE3_BLOCK_LEN), last_block_len);
+
+        const uint8_t flags = CHUNK_END | ROOT | (num_full_blocks == 0 ? CHUNK_START : 0);
+        blake3_compress_in_place(cv, block, (uint8_t)last_block_len, 0, flags);
+        store_cv_words(hashes[i].data(), cv);
+    }
+
+    return hashes;
+}
+
+mw::Hash blake3_tree::ChunkCV(const uint8_t* pChunk, const size_t len, const uint64_t chunk_counter)
+{
+    assert(len > 0 && len <= CHUNK_LEN);
+
+    blake3_chunk_state state;
+    chunk_state_init(&state, IV, 0);
+    state.chunk_counter = chunk_counter;
+    chunk_state_update(&state, pChunk, len);
+
+    output_t output = chunk_state_output(&state);
+    mw::Hash cv;
+    output_chaining_value(&output, cv.data());
+    return cv;
+}
+
+static output_t ParentOutput(const mw::Hash& left, const mw::Hash& right)
+{
+    uint8_t block[BLAKE3_BLOCK_LEN];
+    memcpy(block, left.data(), BLAKE3_OUT_LEN);
+    memcpy(block + BLAKE3_OUT_LEN, right.data(), BLAKE3_OUT_LEN);
+    return parent_output(block, IV, 0);
+}
+
+mw::Hash blake3_tree::ParentCV(const mw::Hash& left, const mw::Hash& right)
+{
+    output_t output = ParentOutput(left, right);
+    mw::Hash cv;
+    output_chaining_value(&output, cv.data());
+    return cv;
+}
+
+mw::Hash blake3_tree::ParentRoot(const mw::Hash& left, const mw::Hash& right)
+{
+    output_t output = ParentOutput(left, right);
+    mw::Hash root;
+    output_root_bytes(&output, 0, root.data(), root.size());
+    return root;
 }
\ No newline at end of file
@@ -1,18 +1,37 @@
 #include <mw/crypto/Schnorr.h>
 #include "Context.h"
 #include "ConversionUtil.h"
+#include "ScratchSpace.h"
 
-#include <caches/Cache.h>
 #include <mw/common/Logger.h>
+#include <mw/crypto/VerificationCache.h>
 #include <mw/exceptions/CryptoException.h>
 #include <mw/util/VectorUtil.h>
 
-static Locked<LRUCache<SignedMessage, bool>> CACHE(std::make_shared<LRUCache<SignedMessage, bool>>(3000));
+static VerificationCache CACHE;
 static Locked<Context> SCHNORR_CONTEXT(std::make_shared<Context>());
 
 static constexpr uint64_t MAX_WIDTH = 1 << 20;
 static constexpr size_t SCRATCH_SPACE_SIZE = 256 * MAX_WIDTH;
 
+// Each thread reuses its own scratch space, rather than creating one for every batch.
+static thread_local std::unique_ptr<ScratchSpace> THREAD_SCRATCH;
+
+static uint256 ComputeCacheEntry(const SignedMessage& signed_message)
+{
+    const mw::Hash& msg_hash = signed_message.GetMsgHash();
+    const PublicKey& pubkey = signed_message.GetPublicKey();
+    const Signature& signature = signed_message.GetSignature();
+
+    uint256 entry;
+    CACHE.GetSaltedHasher()
+        .Write(msg_hash.data(), msg_hash.size())
+        .Write(pubkey.data(), pubkey.size())
+        .Write(signature.data(), Signature::SIZE)
+        .Finalize(entry.begin());
+    return entry;
+}
+
 Signature Schnorr::Sign(
     const uint8_t* secretKey,
     const mw::Hash& message)
@@ -49,8 +68,8 @@ bool Schnorr::Verify(
     const PublicKey& sumPubKeys,
     const mw::Hash& message)
 {
-    SignedMessage signed_message(message, sumPubKeys, signature);
-    if (CACHE.Write()->Cached(signed_message)) {
+    const uint256 cache_entry = ComputeCacheEntry(SignedMessage(message, sumPubKeys, signature));
+    if (CACHE.Contains(cache_entry, false)) {
         return true;
     }
 
@@ -67,7 +86,7 @@ bool Schnorr::Verify(
         false
     );
     if (verifyResult == 1) {
-        CACHE.Write()->Put(signed_message, true);
+        CACHE.Insert(cache_entry);
     }
 
     return verifyResult == 1;
@@ -75,48 +94,62 @@ bool Schnorr::Verify(
 
 bool Schnorr::BatchVerify(const std::vector<SignedMessage>& signatures)
 {
-    std::vector<SignedMessage> unverified_messages;
+    std::vector<uint256> unverified_entries;
     std::vector<secp256k1_pubkey> parsedPubKeys;
     std::vector<secp256k1_schnorrsig> parsedSignatures;
     std::vector<const uint8_t*> messageData;
 
+    unverified_entries.reserve(signatures.size());
+    parsedPubKeys.reserve(signatures.size());
+    parsedSignatures.reserve(signatures.size());
+    messageData.reserve(signatures.size());
+
     for (const SignedMessage& signed_message : signatures) {
-        if (CACHE.Write()->Cached(signed_message)) {
+        uint256 cache_entry = ComputeCacheEntry(signed_message);
+        if (CACHE.Contains(cache_entry, false)) {
             continue;
         }
 
-        unverified_messages.push_back(signed_message);
+        unverified_entries.push_back(std::move(cache_entry));
         parsedPubKeys.push_back(ConversionUtil::ToSecp256k1(signed_message.GetPublicKey()));
         parsedSignatures.push_back(ConversionUtil::ToSecp256k1(signed_message.GetSignature()));
         messageData.push_back(signed_message.GetMsgHash().data());
     }
 
-    if (unverified_messages.empty()) {
+    if (unverified_entries.empty()) {
         return true;
     }
 
     std::vector<secp256k1_pubkey*> pubKeyPtrs = VectorUtil::ToPointerVec(parsedPubKeys);
     std::vector<secp256k1_schnorrsig*> signaturePtrs = VectorUtil::ToPointerVec(parsedSignatures);
 
-    secp256k1_scratch_space* pScratchSpace = secp256k1_scratch_space_create(
-        SCHNORR_CONTEXT.Read()->Get(),
-        SCRATCH_SPACE_SIZE
-    );
+    auto context_reader = SCHNORR_CONTEXT.Read();
+    ScratchSpaceLease scratch(THREAD_SCRATCH, context_reader->Get(), SCRATCH_SPACE_SIZE);
     const int verifyResult = secp256k1_schnorrsig_verify_batch(
-        SCHNORR_CONTEXT.Read()->Get(),
-        pScratchSpace,
+        context_reader->Get(),
+        scratch.Get(),
         signaturePtrs.data(),
         messageData.data(),
         pubKeyPtrs.data(),
-        unverified_messages.size()
+        unverified_entries.size()
     );
-    secp256k1_scratch_space_destroy(pScratchSpace);
 
     if (verifyResult == 1) {
-        for (const SignedMessage& message : unverified_messages) {
-            CACHE.Write()->Put(message, true);
+        scratch.SetSucceeded();
+        for (const uint256& cache_entry : unverified_entries) {
+            CACHE.Insert(cache_entry);
         }
     }
 
     return verifyResult == 1;
+}
+
+size_t Schnorr::InitCache(const uint256& nonce, const size_t max_bytes)
+{
+    return CACHE.Setup(nonce, max_bytes);
+}
+
+VerificationCache::Stats Schnorr::GetCacheStats()
+{
+    return CACHE.GetStats();
 }
\ No newline at end of file
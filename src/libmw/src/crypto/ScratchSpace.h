@@ -0,0 +1,82 @@
+#pragma once
+
+#include "secp256k1-zkp.h"
+
+#include <mw/exceptions/CryptoException.h>
+
+#include <atomic>
+#include <memory>
+
+//
+// Owns a secp256k1 scratch space. The scratch space only caps how much memory secp256k1 may use.
+// Its frames are allocated per call, sized to the width of the batch.
+//
+// The scratch space keeps a pointer to the context's error callback, so the context must outlive it.
+//
+class ScratchSpace
+{
+public:
+    ScratchSpace(const secp256k1_context* pContext, const size_t max_size)
+        : m_pScratch(secp256k1_scratch_space_create(pContext, max_size))
+    {
+        if (m_pScratch == nullptr) {
+            ThrowCrypto("Failed to create scratch space.");
+        }
+
+        NumCreated().fetch_add(1, std::memory_order_relaxed);
+    }
+
+    ~ScratchSpace() { secp256k1_scratch_space_destroy(m_pScratch); }
+
+    ScratchSpace(const ScratchSpace&) = delete;
+    ScratchSpace& operator=(const ScratchSpace&) = delete;
+
+    secp256k1_scratch_space* Get() noexcept { return m_pScratch; }
+
+    // The number of scratch spaces created so far, across all threads.
+    static std::atomic<uint64_t>& NumCreated() noexcept
+    {
+        static std::atomic<uint64_t> num_created{0};
+        return num_created;
+    }
+
+private:
+    secp256k1_scratch_space* m_pScratch;
+};
+
+//
+// Lends out the calling thread's scratch space, held in a thread_local slot, for a single call.
+// The scratch space is created on first use and then reused by every call on the thread.
+//
+// secp256k1 doesn't release its frames on some of the paths that reject a proof, so unless
+// the call is marked as succeeded, the scratch space is destroyed when the lease ends,
+// and the next call on the thread creates a fresh one.
+//
+class ScratchSpaceLease
+{
+public:
+    ScratchSpaceLease(std::unique_ptr<ScratchSpace>& slot, const secp256k1_context* pContext, const size_t max_size)
+        : m_slot(slot), m_succeeded(false)
+    {
+        if (m_slot == nullptr) {
+            m_slot = std::make_unique<ScratchSpace>(pContext, max_size);
+        }
+    }
+
+    ~ScratchSpaceLease()
+    {
+        if (!m_succeeded) {
+            m_slot.reset();
+        }
+    }
+
+    ScratchSpaceLease(const ScratchSpaceLease&) = delete;
+    ScratchSpaceLease& operator=(const ScratchSpaceLease&) = delete;
+
+    secp256k1_scratch_space* Get() noexcept { return m_slot->Get(); }
+    void SetSucceeded() noexcept { m_succeeded = true; }
+
+private:
+    std::unique_ptr<ScratchSpace>& m_slot;
+    bool m_succeeded;
+};
\ No newline at end of file
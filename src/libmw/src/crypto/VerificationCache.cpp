@@ -0,0 +1,60 @@
+#include <mw/crypto/VerificationCache.h>
+
+VerificationCache::VerificationCache()
+    : m_maxElements(0), m_hits(0), m_misses(0) { }
+
+bool VerificationCache::Contains(const uint256& entry, const bool erase)
+{
+    if (m_maxElements == 0) {
+        m_misses.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    Shard& shard = GetShard(entry);
+
+    bool found;
+    {
+        boost::shared_lock<boost::shared_mutex> lock(shard.mutex);
+        found = shard.entries.contains(entry, erase);
+    }
+
+    (found ? m_hits : m_misses).fetch_add(1, std::memory_order_relaxed);
+    return found;
+}
+
+void VerificationCache::Insert(uint256 entry)
+{
+    if (m_maxElements == 0) {
+        return;
+    }
+
+    Shard& shard = GetShard(entry);
+
+    boost::unique_lock<boost::shared_mutex> lock(shard.mutex);
+    shard.entries.insert(entry);
+}
+
+size_t VerificationCache::Setup(const uint256& nonce, const size_t bytes)
+{
+    // Like the script signature cache, pad the nonce to 64 bytes so the salt is absorbed into the hasher's midstate.
+    static constexpr unsigned char PADDING[32] = {0};
+    m_saltedHasher.Reset();
+    m_saltedHasher.Write(nonce.begin(), 32);
+    m_saltedHasher.Write(PADDING, 32);
+
+    m_maxElements = 0;
+    for (Shard& shard : m_shards) {
+        m_maxElements += shard.entries.setup_bytes(bytes / NUM_SHARDS);
+    }
+
+    return m_maxElements;
+}
+
+VerificationCache::Stats VerificationCache::GetStats() const noexcept
+{
+    return Stats{
+        m_hits.load(std::memory_order_relaxed),
+        m_misses.load(std::memory_order_relaxed),
+        m_maxElements
+    };
+}
\ No newline at end of file
@@ -1,22 +1,71 @@
 #include <mw/db/CoinDB.h>
+#include <mw/db/ProofDB.h>
+#include <mw/common/Logger.h>
 #include "common/Database.h"
 
-static const DBTable UTXO_TABLE = { 'U' };
+// Compact UTXOs, without their rangeproofs.
+static const DBTable UTXO_TABLE = { 'C' };
+
+// UTXOs used to be stored with their full output, keyed by either the hex-encoded or the raw output ID.
+static const DBTable LEGACY_UTXO_TABLE = { 'U' };
+
+// Lengths of the raw and the hex-encoded output ID keys of the legacy table.
+static constexpr size_t LEGACY_KEY_LENS[] = { 32, 64 };
+
+// Holds the version of the coin database format, under an empty key.
+static const DBTable VERSION_TABLE = { 'V' };
+
+// Number of UTXOs rewritten per batch when migrating legacy UTXOs.
+static constexpr size_t MIGRATION_BATCH_SIZE = 10'000;
+
+struct CoinDBVersion : public Traits::ISerializable
+{
+    CoinDBVersion() : version(0) { }
+    explicit CoinDBVersion(uint32_t version_in) : version(version_in) { }
+
+    uint32_t version;
+
+    IMPL_SERIALIZABLE(CoinDBVersion, obj)
+    {
+        READWRITE(obj.version);
+    }
+};
+
+static std::string UTXOKey(const mw::Hash& output_id)
+{
+    return std::string((const char*)output_id.data(), output_id.size());
+}
 
 CoinDB::CoinDB(mw::DBWrapper* pDBWrapper, mw::DBBatch* pBatch)
-    : m_pDatabase(std::make_unique<Database>(pDBWrapper, pBatch)) { }
+    : m_pDBWrapper(pDBWrapper), m_pDatabase(std::make_unique<Database>(pDBWrapper, pBatch)) { }
 
 CoinDB::~CoinDB() { }
 
+uint32_t CoinDB::GetVersion() const
+{
+    auto pVersion = m_pDatabase->Get<CoinDBVersion>(VERSION_TABLE, "");
+    return pVersion != nullptr ? pVersion->item->version : 0;
+}
+
 std::unordered_map<mw::Hash, UTXO::CPtr> CoinDB::GetUTXOs(const std::vector<mw::Hash>& output_ids) const
 {
     std::unordered_map<mw::Hash, UTXO::CPtr> utxos;
 
-    for (const mw::Hash& output_id : output_ids) {
-        auto pUTXO = m_pDatabase->Get<UTXO>(UTXO_TABLE, output_id.ToHex());
+    if (output_ids.size() == 1) {
+        auto pUTXO = m_pDatabase->Get<CompactUTXO>(UTXO_TABLE, UTXOKey(output_ids.front()));
         if (pUTXO != nullptr) {
-            utxos.insert({output_id, pUTXO->item});
+            utxos.insert({output_ids.front(), pUTXO->item->GetUTXO()});
         }
+
+        return utxos;
+    }
+
+    std::vector<std::string> keys;
+    keys.reserve(output_ids.size());
+    std::transform(output_ids.cbegin(), output_ids.cend(), std::back_inserter(keys), UTXOKey);
+
+    for (const DBEntry<CompactUTXO>& entry : m_pDatabase->GetMany<CompactUTXO>(UTXO_TABLE, std::move(keys))) {
+        utxos.insert({entry.item->GetUTXO()->GetOutputID(), entry.item->GetUTXO()});
     }
 
     return utxos;
@@ -24,11 +73,11 @@ std::unordered_map<mw::Hash, UTXO::CPtr> CoinDB::GetUTXOs(const std::vector<mw::
 
 void CoinDB::AddUTXOs(const std::vector<UTXO::CPtr>& utxos)
 {
-    std::vector<DBEntry<UTXO>> entries;
+    std::vector<DBEntry<CompactUTXO>> entries;
     std::transform(
         utxos.cbegin(), utxos.cend(),
         std::back_inserter(entries),
-        [](const UTXO::CPtr& pUTXO) { return DBEntry<UTXO>(pUTXO->GetOutputID().ToHex(), pUTXO); }
+        [](const UTXO::CPtr& pUTXO) { return DBEntry<CompactUTXO>(UTXOKey(pUTXO->GetOutputID()), CompactUTXO(pUTXO)); }
     );
 
     m_pDatabase->Put(UTXO_TABLE, entries);
@@ -37,11 +86,113 @@ void CoinDB::AddUTXOs(const std::vector<UTXO::CPtr>& utxos)
 void CoinDB::RemoveUTXOs(const std::vector<mw::Hash>& output_ids)
 {
     for (const mw::Hash& output_id : output_ids) {
-        m_pDatabase->Delete(UTXO_TABLE, output_id.ToHex());
+        m_pDatabase->Delete(UTXO_TABLE, UTXOKey(output_id));
     }
 }
 
 void CoinDB::RemoveAllUTXOs()
 {
-    m_pDatabase->DeleteAll(UTXO_TABLE);
+    m_pDatabase->DeleteAll(UTXO_TABLE, { mw::Hash::size() });
+}
+
+size_t CoinDB::MigrateLegacyUTXOs()
+{
+    size_t num_migrated = 0;
+    std::vector<std::string> legacy_keys;
+    std::vector<UTXO::CPtr> utxos;
+
+    auto write_batch = [&]() {
+        auto pBatch = m_pDBWrapper->CreateBatch();
+
+        Database legacyDB(m_pDBWrapper, pBatch.get());
+        for (const std::string& key : legacy_keys) {
+            legacyDB.Delete(LEGACY_UTXO_TABLE, key);
+        }
+
+        std::vector<std::pair<mmr::LeafIndex, RangeProof::CPtr>> proofs;
+        for (const UTXO::CPtr& pUTXO : utxos) {
+            proofs.push_back({ pUTXO->GetLeafIndex(), pUTXO->GetRangeProof() });
+        }
+
+        CoinDB(m_pDBWrapper, pBatch.get()).AddUTXOs(utxos);
+        ProofDB(m_pDBWrapper, pBatch.get()).Add(proofs);
+        pBatch->Commit();
+
+        num_migrated += utxos.size();
+        legacy_keys.clear();
+        utxos.clear();
+    };
+
+    // Keys are stored with their length first, so the raw and the hex-encoded keys are walked separately.
+    // Each batch deletes the legacy keys it rewrites, so an interrupted migration picks up where it left off.
+    for (const size_t key_len : LEGACY_KEY_LENS) {
+        auto pIter = m_pDatabase->NewIterator(LEGACY_UTXO_TABLE, key_len);
+        while (pIter != nullptr && pIter->Valid()) {
+            std::string key;
+            std::vector<uint8_t> item_vec;
+            if (!pIter->GetKey(key) || key.size() != key_len + 1 || key.front() != LEGACY_UTXO_TABLE.GetPrefix() || !pIter->GetValue(item_vec)) {
+                break;
+            }
+
+            auto pUTXO = std::make_shared<UTXO>();
+            CDataStream(item_vec, SER_DISK, PROTOCOL_VERSION) >> *pUTXO;
+
+            legacy_keys.push_back(key.substr(1));
+            utxos.push_back(pUTXO);
+            if (utxos.size() >= MIGRATION_BATCH_SIZE) {
+                write_batch();
+                LOG_INFO_F("Migrated {} MWEB coins", num_migrated);
+            }
+
+            pIter->Next();
+        }
+    }
+
+    if (!utxos.empty()) {
+        write_batch();
+    }
+
+    // Only bumped once every legacy UTXO has been rewritten, so an interrupted migration is resumed on the next start.
+    Database(m_pDBWrapper, nullptr).Put(VERSION_TABLE, std::vector<DBEntry<CoinDBVersion>>{ { "", CoinDBVersion(CURRENT_VERSION) } });
+
+    return num_migrated;
+}
+
+std::unique_ptr<UTXOCursor> CoinDB::NewCursor() const
+{
+    return std::make_unique<UTXOCursor>(m_pDatabase->NewIterator(UTXO_TABLE, mw::Hash::size()));
+}
+
+UTXOCursor::UTXOCursor(std::unique_ptr<mw::DBIterator> pIter)
+    : m_pIter(std::move(pIter)) { }
+
+UTXOCursor::~UTXOCursor() { }
+
+bool UTXOCursor::Valid() const
+{
+    std::string key;
+    return m_pIter != nullptr && m_pIter->Valid() && m_pIter->GetKey(key)
+        && key.size() == mw::Hash::size() + 1 && key.front() == UTXO_TABLE.GetPrefix();
+}
+
+void UTXOCursor::Next()
+{
+    m_pIter->Next();
+}
+
+UTXO::CPtr UTXOCursor::GetUTXO() const
+{
+    std::string key;
+    std::vector<uint8_t> item_vec;
+    if (!m_pIter->GetKey(key) || key.empty() || !m_pIter->GetValue(item_vec)) {
+        return nullptr;
+    }
+
+    try {
+        CompactUTXO compact = CompactUTXO::FromDBKey(key.substr(1));
+        CDataStream(item_vec, SER_DISK, PROTOCOL_VERSION) >> compact;
+        return compact.GetUTXO();
+    } catch (const std::exception&) {
+        return nullptr;
+    }
 }
\ No newline at end of file
@@ -2,6 +2,9 @@
 #include "common/Database.h"
 #include "common/SerializableVec.h"
 
+// Leaves are keyed by their decimal leaf index, which is at most 20 digits long.
+static constexpr size_t MAX_LEAF_KEY_LEN = 20;
+
 LeafDB::LeafDB(const char prefix, mw::DBWrapper* pDBWrapper, mw::DBBatch* pBatch)
     : m_prefix(prefix), m_pDatabase(std::make_unique<Database>(pDBWrapper, pBatch))
 {
@@ -44,5 +47,10 @@ void LeafDB::Remove(const std::vector<mmr::LeafIndex>& indices)
 
 void LeafDB::RemoveAll()
 {
-    m_pDatabase->DeleteAll(m_prefix);
+    std::vector<size_t> key_lens;
+    for (size_t key_len = 1; key_len <= MAX_LEAF_KEY_LEN; key_len++) {
+        key_lens.push_back(key_len);
+    }
+
+    m_pDatabase->DeleteAll(m_prefix, key_lens);
 }
\ No newline at end of file
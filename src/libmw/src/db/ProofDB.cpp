@@ -0,0 +1,54 @@
+#include <mw/db/ProofDB.h>
+#include <crypto/common.h>
+#include "common/Database.h"
+
+static const DBTable PROOF_TABLE = { 'R' };
+
+// Proofs are keyed by their big-endian leaf index.
+static constexpr size_t PROOF_KEY_LEN = 8;
+
+static std::string ProofKey(const mmr::LeafIndex& idx)
+{
+    char key[PROOF_KEY_LEN];
+    WriteBE64((unsigned char*)key, idx.Get());
+    return std::string(key, sizeof(key));
+}
+
+ProofDB::ProofDB(mw::DBWrapper* pDBWrapper, mw::DBBatch* pBatch)
+    : m_pDatabase(std::make_unique<Database>(pDBWrapper, pBatch)) { }
+
+ProofDB::~ProofDB() { }
+
+RangeProof::CPtr ProofDB::Get(const mmr::LeafIndex& idx) const
+{
+    auto pEntry = m_pDatabase->Get<RangeProof>(PROOF_TABLE, ProofKey(idx));
+    return pEntry != nullptr ? pEntry->item : nullptr;
+}
+
+void ProofDB::Add(const std::vector<std::pair<mmr::LeafIndex, RangeProof::CPtr>>& proofs)
+{
+    if (proofs.empty()) {
+        return;
+    }
+
+    std::vector<DBEntry<RangeProof>> entries;
+    std::transform(
+        proofs.cbegin(), proofs.cend(), std::back_inserter(entries),
+        [](const std::pair<mmr::LeafIndex, RangeProof::CPtr>& proof) {
+            return DBEntry<RangeProof>(ProofKey(proof.first), proof.second);
+        }
+    );
+    m_pDatabase->Put(PROOF_TABLE, entries);
+}
+
+void ProofDB::Remove(const std::vector<mmr::LeafIndex>& indices)
+{
+    for (const mmr::LeafIndex& idx : indices) {
+        m_pDatabase->Delete(PROOF_TABLE, ProofKey(idx));
+    }
+}
+
+void ProofDB::RemoveAll()
+{
+    m_pDatabase->DeleteAll(PROOF_TABLE, { PROOF_KEY_LEN });
+}
\ No newline at end of file
@@ -16,4 +16,14 @@ struct DBEntry
 
     std::string key;
     std::shared_ptr<const T> item;
-};
\ No newline at end of file
+};
+
+//
+// Creates the item that the entry stored under the given key (excluding the table prefix) is deserialized into.
+// Items that can make use of their key, e.g. because it's a hash of their contents, provide a static FromDBKey.
+//
+template<typename T>
+auto NewDBItem(const std::string& key, int) -> decltype(T::FromDBKey(key)) { return T::FromDBKey(key); }
+
+template<typename T>
+T NewDBItem(const std::string&, long) { return T(); }
\ No newline at end of file
@@ -38,19 +38,16 @@ public:
         typename SFINAE = typename std::enable_if_t<std::is_base_of<Traits::ISerializable, T>::value>>
     std::unique_ptr<DBEntry<T>> Get(const DBTable& table, const std::string& key) const noexcept
     {
-        auto table_key = table.BuildKey(key);
-        auto iter = m_added.find_last(table_key);
-        if (iter != nullptr) {
-            auto pObject = std::dynamic_pointer_cast<const T>(iter);
-            if (pObject != nullptr) {
-                return std::make_unique<DBEntry<T>>(key, pObject);
-            }
+        auto pAdded = GetAdded<T>(table, key);
+        if (pAdded != nullptr) {
+            return pAdded;
         }
 
+        auto table_key = table.BuildKey(key);
         std::vector<uint8_t> entry;
         const bool status = m_pDB->Read(table_key, entry);
         if (status) {
-            T item;
+            T item = NewDBItem<T>(key, 0);
             CDataStream(entry, SER_DISK, PROTOCOL_VERSION) >> item;
             return std::make_unique<DBEntry<T>>(key, std::move(item));
         }
@@ -58,6 +55,24 @@ public:
         return nullptr;
     }
 
+    //
+    // Returns the item most recently added by this transaction, without checking the database.
+    //
+    template<typename T,
+        typename SFINAE = typename std::enable_if_t<std::is_base_of<Traits::ISerializable, T>::value>>
+    std::unique_ptr<DBEntry<T>> GetAdded(const DBTable& table, const std::string& key) const noexcept
+    {
+        auto iter = m_added.find_last(table.BuildKey(key));
+        if (iter != nullptr) {
+            auto pObject = std::dynamic_pointer_cast<const T>(iter);
+            if (pObject != nullptr) {
+                return std::make_unique<DBEntry<T>>(key, pObject);
+            }
+        }
+
+        return nullptr;
+    }
+
     void Delete(const DBTable& table, const std::string& key)
     {
         auto table_key = table.BuildKey(key);
@@ -5,6 +5,7 @@
 #include "DBEntry.h"
 
 #include <mw/interfaces/db_interface.h>
+#include <algorithm>
 #include <vector>
 #include <cassert>
 #include <memory>
@@ -38,7 +39,7 @@ public:
         std::vector<uint8_t> item_vec;
         const bool status = m_pDB->Read(table.BuildKey(key), item_vec);
         if (status) {
-            T item;
+            T item = NewDBItem<T>(key, 0);
             CDataStream(item_vec, SER_DISK, PROTOCOL_VERSION) >> item;
             return std::make_unique<DBEntry<T>>(key, std::move(item));
         }
@@ -46,6 +47,50 @@ public:
         return nullptr;
     }
 
+    //
+    // Looks up multiple keys at once.
+    // The keys are sorted, so the lookups are performed in a single forward sweep of one iterator.
+    // Only the entries that were found are returned.
+    //
+    template<typename T,
+        typename SFINAE = typename std::enable_if_t<std::is_base_of<Traits::ISerializable, T>::value>>
+    std::vector<DBEntry<T>> GetMany(const DBTable& table, std::vector<std::string> keys) const
+    {
+        std::vector<DBEntry<T>> entries;
+        if (!m_pDB) return entries;
+
+        std::sort(keys.begin(), keys.end());
+        keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+        std::unique_ptr<mw::DBIterator> pIter;
+        for (const std::string& key : keys) {
+            if (m_pTx != nullptr) {
+                auto pAdded = m_pTx->GetAdded<T>(table, key);
+                if (pAdded != nullptr) {
+                    entries.push_back(std::move(*pAdded));
+                    continue;
+                }
+            }
+
+            if (pIter == nullptr) {
+                pIter = m_pDB->NewIterator();
+            }
+
+            const std::string table_key = table.BuildKey(key);
+            pIter->Seek(table_key);
+
+            std::string found_key;
+            std::vector<uint8_t> item_vec;
+            if (pIter->Valid() && pIter->GetKey(found_key) && found_key == table_key && pIter->GetValue(item_vec)) {
+                T item = NewDBItem<T>(key, 0);
+                CDataStream(item_vec, SER_DISK, PROTOCOL_VERSION) >> item;
+                entries.push_back(DBEntry<T>(key, std::move(item)));
+            }
+        }
+
+        return entries;
+    }
+
     template<typename T,
         typename SFINAE = typename std::enable_if_t<std::is_base_of<Traits::ISerializable, T>::value>>
     void Put(const DBTable& table, const std::vector<DBEntry<T>>& entries)
@@ -72,19 +117,40 @@ public:
         }
     }
 
-    void DeleteAll(const DBTable& table)
+    //
+    // Returns an iterator positioned at the first entry of the table whose key (excluding the table prefix)
+    // is key_len bytes long. Keys are stored with their length first, so the entries of a table are only
+    // adjacent to the entries whose keys have the same length. Callers must stop at the first key that
+    // doesn't match both the prefix and the length.
+    // The iterator reads from the database as of when it was created, even if entries are written while it's in use.
+    //
+    std::unique_ptr<mw::DBIterator> NewIterator(const DBTable& table, const size_t key_len) const
+    {
+        if (!m_pDB) return nullptr;
+
+        auto pIter = m_pDB->NewIterator();
+        pIter->Seek(table.BuildKey(std::string(key_len, '\0')));
+        return pIter;
+    }
+
+    //
+    // Deletes every entry of the table whose key (excluding the table prefix) is one of the given lengths.
+    // Since keys are stored with their length first, each length is walked separately, as with NewIterator.
+    //
+    void DeleteAll(const DBTable& table, const std::vector<size_t>& key_lens)
     {
         auto pBatch = m_pDB->CreateBatch();
 
-        auto iter = m_pDB->NewIterator();
-        iter->Seek(std::to_string(table.GetPrefix()));
-        while (iter->Valid()) {
-            std::string key;
-            if (iter->GetKey(key) && !key.empty() && key.front() == table.GetPrefix()) {
+        for (const size_t key_len : key_lens) {
+            auto pIter = NewIterator(table, key_len);
+            while (pIter->Valid()) {
+                std::string key;
+                if (!pIter->GetKey(key) || key.size() != key_len + 1 || key.front() != table.GetPrefix()) {
+                    break;
+                }
+
                 pBatch->Erase(key);
-                iter->Next();
-            } else {
-                break;
+                pIter->Next();
             }
         }
 
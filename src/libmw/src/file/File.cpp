@@ -155,6 +155,24 @@ size_t File::GetSize() const
     return size;
 }
 
+void File::Replace(const std::vector<uint8_t>& bytes)
+{
+    ghc::filesystem::path tmp_path = m_path.m_path;
+    tmp_path += ".tmp";
+
+    File tmp_file(tmp_path);
+    if (tmp_file.Exists()) {
+        tmp_file.GetPath().Remove();
+    }
+    tmp_file.Write(bytes);
+
+    std::error_code ec;
+    ghc::filesystem::rename(tmp_path, m_path.m_path, ec);
+    if (ec) {
+        ThrowFile_F("Failed to rename {} to {}", tmp_file, m_path);
+    }
+}
+
 void File::CopyTo(const FilePath& new_path) const
 {
     if (new_path.Exists()) {
@@ -26,17 +26,109 @@ bool ILeafSet::Contains(const LeafIndex& idx) const noexcept
     return GetByte(idx.Get() / 8) & BitToByte(idx.Get() % 8);
 }
 
+// Returns the largest power of 2 that is strictly less than n, where n > 1.
+static uint64_t LargestPowerOf2Below(const uint64_t n)
+{
+    uint64_t power = 1;
+    while ((power << 1) < n) {
+        power <<= 1;
+    }
+
+    return power;
+}
+
 mw::Hash ILeafSet::Root() const
 {
-    uint64_t numBytes = (m_nextLeafIdx.Get() + 7) / 8;
+    const uint64_t numBytes = (m_nextLeafIdx.Get() + 7) / 8;
+    if (numBytes <= blake3_tree::CHUNK_LEN) {
+        std::vector<uint8_t> bytes(numBytes);
+        ReadBytes(0, numBytes, bytes.data());
+        return Hashed(bytes);
+    }
+
+    // Per the BLAKE3 tree layout, the left subtree holds the largest power of 2 chunks that leaves at least 1 byte for the right.
+    const uint64_t numChunks = (numBytes + blake3_tree::CHUNK_LEN - 1) / blake3_tree::CHUNK_LEN;
+    const uint64_t numLeft = LargestPowerOf2Below(numChunks);
+    return blake3_tree::ParentRoot(
+        CalcRangeCV(0, numLeft, numBytes),
+        CalcRangeCV(numLeft, numChunks - numLeft, numBytes)
+    );
+}
 
-    std::vector<uint8_t> bytes(numBytes);
-    for (uint64_t byte_idx = 0; byte_idx < numBytes; byte_idx++) {
-        uint8_t byte = GetByte(byte_idx);
-        bytes[byte_idx] = byte;
+mw::Hash ILeafSet::CalcRangeCV(const uint64_t firstChunk, const uint64_t numChunks, const uint64_t numBytes) const
+{
+    const bool is_power_of_2 = (numChunks & (numChunks - 1)) == 0;
+    if (is_power_of_2 && (firstChunk + numChunks) * blake3_tree::CHUNK_LEN <= numBytes) {
+        uint8_t height = 0;
+        while ((1ull << height) < numChunks) {
+            ++height;
+        }
+
+        return GetSubtreeCV(height, firstChunk >> height);
+    }
+
+    if (numChunks == 1) {
+        // The final chunk is partial, so its chaining value can't be cached.
+        const uint64_t chunkStart = firstChunk * blake3_tree::CHUNK_LEN;
+        std::vector<uint8_t> chunk(numBytes - chunkStart);
+        ReadBytes(chunkStart, chunk.size(), chunk.data());
+        return blake3_tree::ChunkCV(chunk.data(), chunk.size(), firstChunk);
     }
 
-    return Hashed(bytes);
+    const uint64_t numLeft = LargestPowerOf2Below(numChunks);
+    return blake3_tree::ParentCV(
+        CalcRangeCV(firstChunk, numLeft, numBytes),
+        CalcRangeCV(firstChunk + numLeft, numChunks - numLeft, numBytes)
+    );
+}
+
+mw::Hash ILeafSet::GetSubtreeCV(const uint8_t height, const uint64_t index) const
+{
+    for (const uint64_t chunk : m_dirtyChunks) {
+        for (uint8_t h = 0; h < 64; h++) {
+            m_subtreeCVs.erase(std::make_pair(h, chunk >> h));
+        }
+    }
+    m_dirtyChunks.clear();
+
+    auto iter = m_subtreeCVs.find(std::make_pair(height, index));
+    if (iter != m_subtreeCVs.cend()) {
+        return iter->second;
+    }
+
+    mw::Hash cv;
+    if (height == 0) {
+        std::vector<uint8_t> chunk(blake3_tree::CHUNK_LEN);
+        ReadBytes(index * blake3_tree::CHUNK_LEN, chunk.size(), chunk.data());
+        cv = blake3_tree::ChunkCV(chunk.data(), chunk.size(), index);
+    } else {
+        cv = blake3_tree::ParentCV(
+            GetSubtreeCV(height - 1, index << 1),
+            GetSubtreeCV(height - 1, (index << 1) + 1)
+        );
+    }
+
+    m_subtreeCVs.insert({ std::make_pair(height, index), cv });
+    return cv;
+}
+
+void ILeafSet::ReadBytes(const uint64_t byteIdx, const size_t numBytes, uint8_t* pOut) const
+{
+    for (size_t i = 0; i < numBytes; i++) {
+        pOut[i] = GetByte(byteIdx + i);
+    }
+}
+
+void ILeafSet::MarkDirty(const uint64_t byteIdx)
+{
+    m_dirtyChunks.insert(byteIdx / blake3_tree::CHUNK_LEN);
+    ++m_changeCount;
+}
+
+void ILeafSet::ClearSubtreeCache() const
+{
+    m_dirtyChunks.clear();
+    m_subtreeCVs.clear();
 }
 
 void ILeafSet::Rewind(const uint64_t numLeaves, const std::vector<LeafIndex>& leavesToAdd)
@@ -13,9 +13,9 @@ mw::Hash IMMR::Root() const
     // Bag 'em
     mw::Hash hash;
     for (auto iter = peak_indices.crbegin(); iter != peak_indices.crend(); iter++) {
-        mw::Hash peakHash = GetHash(*iter);
+        mw::HashView peakHash = GetHashView(*iter);
         if (hash.IsZero()) {
-            hash = peakHash;
+            hash = peakHash.ToHash();
         } else {
             hash = MMRUtil::CalcParentHash(Index::At(num_nodes), peakHash, hash);
         }
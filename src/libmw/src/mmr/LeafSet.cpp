@@ -34,6 +34,7 @@ void LeafSet::ApplyUpdates(
 {
     for (auto byte : modifiedBytes) {
         m_modifiedBytes[byte.first + 8] = byte.second;
+        MarkDirty(byte.first);
     }
 
     // In case of rewind, make sure to clear everything above the new next
@@ -103,4 +104,26 @@ uint8_t LeafSet::GetByte(const uint64_t byteIdx) const
 void LeafSet::SetByte(const uint64_t byteIdx, const uint8_t value)
 {
     m_modifiedBytes[byteIdx + 8] = value;
+    MarkDirty(byteIdx);
+}
+
+void LeafSet::ReadBytes(const uint64_t byteIdx, const size_t numBytes, uint8_t* pOut) const
+{
+    // Offset by 8 bytes, since first 8 bytes in file represent the next leaf index
+    const uint64_t byteIdxWithOffset = byteIdx + 8;
+
+    size_t numMapped = 0;
+    if (byteIdxWithOffset < m_mmap.size()) {
+        numMapped = std::min<size_t>(numBytes, m_mmap.size() - byteIdxWithOffset);
+        std::vector<uint8_t> mapped = m_mmap.Read(byteIdxWithOffset, numMapped);
+        std::copy(mapped.cbegin(), mapped.cend(), pOut);
+    }
+
+    std::fill(pOut + numMapped, pOut + numBytes, 0);
+
+    for (const auto& byte : m_modifiedBytes) {
+        if (byte.first >= byteIdxWithOffset && byte.first < byteIdxWithOffset + numBytes) {
+            pOut[byte.first - byteIdxWithOffset] = byte.second;
+        }
+    }
 }
\ No newline at end of file
@@ -11,7 +11,7 @@ void LeafSetCache::ApplyUpdates(
     m_nextLeafIdx = nextLeafIdx;
 
     for (auto byte : modifiedBytes) {
-        m_modifiedBytes[byte.first] = byte.second;
+        SetByte(byte.first, byte.second);
     }
 }
 
@@ -19,6 +19,8 @@ void LeafSetCache::Flush(const uint32_t file_index)
 {
     m_pBacked->ApplyUpdates(file_index, m_nextLeafIdx, m_modifiedBytes);
     m_modifiedBytes.clear();
+    m_modifiedChunks.clear();
+    ClearSubtreeCache();
 }
 
 uint8_t LeafSetCache::GetByte(const uint64_t byteIdx) const
@@ -35,4 +37,38 @@ uint8_t LeafSetCache::GetByte(const uint64_t byteIdx) const
 void LeafSetCache::SetByte(const uint64_t byteIdx, const uint8_t value)
 {
     m_modifiedBytes[byteIdx] = value;
+    m_modifiedChunks.insert(byteIdx / blake3_tree::CHUNK_LEN);
+    MarkDirty(byteIdx);
+}
+
+void LeafSetCache::ReadBytes(const uint64_t byteIdx, const size_t numBytes, uint8_t* pOut) const
+{
+    m_pBacked->ReadBytes(byteIdx, numBytes, pOut);
+
+    if (!m_modifiedBytes.empty()) {
+        for (size_t i = 0; i < numBytes; i++) {
+            auto iter = m_modifiedBytes.find(byteIdx + i);
+            if (iter != m_modifiedBytes.cend()) {
+                pOut[i] = iter->second;
+            }
+        }
+    }
+}
+
+mw::Hash LeafSetCache::GetSubtreeCV(const uint8_t height, const uint64_t index) const
+{
+    const uint64_t firstChunk = index << height;
+    auto iter = m_modifiedChunks.lower_bound(firstChunk);
+    if (iter == m_modifiedChunks.cend() || *iter >= firstChunk + (1ull << height)) {
+        return m_pBacked->GetSubtreeCV(height, index);
+    }
+
+    // Cached chaining values also cover unmodified bytes, so they're stale once the backing leafset changes.
+    const uint64_t backedChangeCount = m_pBacked->GetChangeCount();
+    if (backedChangeCount != m_backedChangeCount) {
+        ClearSubtreeCache();
+        m_backedChangeCount = backedChangeCount;
+    }
+
+    return ILeafSet::GetSubtreeCV(height, index);
 }
\ No newline at end of file
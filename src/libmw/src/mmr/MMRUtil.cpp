@@ -3,12 +3,14 @@
 #include <mw/crypto/Hasher.h>
 #include <mw/util/BitUtil.h>
 
+#include <crypto/common.h>
+
 #include <boost/dynamic_bitset.hpp>
 #include <cmath>
 
 using namespace mmr;
 
-mw::Hash MMRUtil::CalcParentHash(const Index& index, const mw::Hash& left_hash, const mw::Hash& right_hash)
+mw::Hash MMRUtil::CalcParentHash(const Index& index, const mw::HashView& left_hash, const mw::HashView& right_hash)
 {
     return Hasher()
         .Append<uint64_t>(index.GetPosition())
@@ -17,6 +19,65 @@ mw::Hash MMRUtil::CalcParentHash(const Index& index, const mw::Hash& left_hash,
         .hash();
 }
 
+std::vector<mw::Hash> MMRUtil::CalcAppendedHashes(const IMMR& mmr, const Span<const mmr::Leaf>& leaves)
+{
+    if (leaves.empty()) {
+        return {};
+    }
+
+    const uint64_t first_pos = mmr.GetNumNodes();
+    const uint64_t end_pos = leaves.back().GetLeafIndex().Next().GetPosition();
+    assert(leaves.front().GetNodeIndex().GetPosition() == first_pos);
+
+    std::vector<mw::Hash> hashes(end_pos - first_pos);
+    std::vector<std::vector<mmr::Index>> parents_by_height;
+    for (const mmr::Leaf& leaf : leaves) {
+        hashes[leaf.GetNodeIndex().GetPosition() - first_pos] = leaf.GetHash();
+
+        mmr::Index next_idx = leaf.GetNodeIndex().GetNext();
+        while (!next_idx.IsLeaf()) {
+            if (parents_by_height.size() < next_idx.GetHeight()) {
+                parents_by_height.resize(next_idx.GetHeight());
+            }
+
+            parents_by_height[next_idx.GetHeight() - 1].push_back(next_idx);
+            next_idx = next_idx.GetNext();
+        }
+    }
+
+    // A parent's children are always at lower heights, and its right child is always new,
+    // so each height only depends on hashes calculated for the heights below it.
+    // Messages are the same as CalcParentHash: position (LE64) | left hash | right hash
+    const size_t msg_len = 8 + (2 * mw::Hash::size());
+    std::vector<uint8_t> messages;
+    std::vector<const uint8_t*> inputs;
+    for (const std::vector<mmr::Index>& parents : parents_by_height) {
+        messages.resize(parents.size() * msg_len);
+        inputs.clear();
+
+        for (size_t i = 0; i < parents.size(); i++) {
+            const mmr::Index& parent = parents[i];
+            const uint64_t left_pos = parent.GetLeftChild().GetPosition();
+            const uint64_t right_pos = parent.GetRightChild().GetPosition();
+            mw::HashView left_hash = left_pos < first_pos ? mmr.GetHashView(parent.GetLeftChild()) : mw::HashView(hashes[left_pos - first_pos]);
+            const mw::Hash& right_hash = hashes[right_pos - first_pos];
+
+            uint8_t* pMsg = messages.data() + (i * msg_len);
+            WriteLE64(pMsg, parent.GetPosition());
+            memcpy(pMsg + 8, left_hash.data(), mw::Hash::size());
+            memcpy(pMsg + 8 + mw::Hash::size(), right_hash.data(), mw::Hash::size());
+            inputs.push_back(pMsg);
+        }
+
+        std::vector<mw::Hash> parent_hashes = HashedMany(inputs, msg_len);
+        for (size_t i = 0; i < parents.size(); i++) {
+            hashes[parents[i].GetPosition() - first_pos] = std::move(parent_hashes[i]);
+        }
+    }
+
+    return hashes;
+}
+
 std::vector<mmr::Index> MMRUtil::CalcPeakIndices(const uint64_t num_nodes)
 {
     if (num_nodes == 0) {
@@ -53,11 +114,11 @@ boost::optional<mw::Hash> MMRUtil::CalcBaggedPeak(const IMMR& mmr, const mmr::In
     // Bag 'em
     boost::optional<mw::Hash> bagged_peak;
     for (auto iter = peak_indices.crbegin(); iter != peak_indices.crend(); iter++) {
-        mw::Hash peakHash = mmr.GetHash(*iter);
+        mw::HashView peakHash = mmr.GetHashView(*iter);
         if (bagged_peak) {
             bagged_peak = MMRUtil::CalcParentHash(next_node, peakHash, *bagged_peak);
         } else {
-            bagged_peak = peakHash;
+            bagged_peak = peakHash.ToHash();
         }
 
         if (*iter == peak_idx) {
@@ -11,14 +11,21 @@ LeafIndex MemMMR::AddLeaf(const Leaf& leaf)
 
     auto nextIdx = leaf.GetNodeIndex().GetNext();
     while (!nextIdx.IsLeaf()) {
-        mw::Hash leftHash = GetHash(nextIdx.GetLeftChild());
-        m_hashes.push_back(MMRUtil::CalcParentHash(nextIdx, leftHash, m_hashes.back()));
+        mw::Hash parentHash = MMRUtil::CalcParentHash(nextIdx, GetHashView(nextIdx.GetLeftChild()), m_hashes.back());
+        m_hashes.push_back(std::move(parentHash));
         nextIdx = nextIdx.GetNext();
     }
 
     return leaf.GetLeafIndex();
 }
 
+void MemMMR::AddLeaves(const Span<const Leaf>& leaves)
+{
+    std::vector<mw::Hash> hashes = MMRUtil::CalcAppendedHashes(*this, leaves);
+    m_leaves.insert(m_leaves.end(), leaves.begin(), leaves.end());
+    m_hashes.insert(m_hashes.end(), std::make_move_iterator(hashes.begin()), std::make_move_iterator(hashes.end()));
+}
+
 Leaf MemMMR::GetLeaf(const LeafIndex& leafIdx) const
 {
     assert(leafIdx.Get() < m_leaves.size());
@@ -31,6 +38,12 @@ mw::Hash MemMMR::GetHash(const Index& idx) const
     return m_hashes[idx.GetPosition()];
 }
 
+mw::HashView MemMMR::GetHashView(const Index& idx) const
+{
+    assert(idx.GetPosition() < m_hashes.size());
+    return m_hashes[idx.GetPosition()];
+}
+
 LeafIndex MemMMR::GetNextLeafIdx() const noexcept
 {
     return LeafIndex::At(GetNumLeaves());
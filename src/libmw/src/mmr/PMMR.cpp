@@ -4,9 +4,34 @@
 #include <mw/common/Logger.h>
 #include <mw/db/LeafDB.h>
 #include <mw/exceptions/NotFoundException.h>
+#include <set>
 
 using namespace mmr;
 
+/// <summary>
+/// Describes the committed state of the hash file for a single file_index.
+/// Hashes are appended in place, so many file indices share the same data files,
+/// each one covering a prefix of them.
+/// </summary>
+struct HashFileManifest : public Traits::ISerializable
+{
+    HashFileManifest()
+        : version(0) { }
+    HashFileManifest(uint8_t version_in, std::vector<AppendOnlyFile::Segment> segments_in)
+        : version(version_in), segments(std::move(segments_in)) { }
+
+    // Version byte that allows for future modifications to the manifest schema.
+    uint8_t version;
+
+    // Data files holding the committed hashes, in order.
+    std::vector<AppendOnlyFile::Segment> segments;
+
+    IMPL_SERIALIZABLE(HashFileManifest, obj)
+    {
+        READWRITE(obj.version, obj.segments);
+    }
+};
+
 PMMR::Ptr PMMR::Open(
     const char dbPrefix,
     const FilePath& mmr_dir,
@@ -14,9 +39,26 @@ PMMR::Ptr PMMR::Open(
     const mw::DBWrapper::Ptr& pDBWrapper,
     const PruneList::CPtr& pPruneList)
 {
-    auto pHashFile = AppendOnlyFile::Load(
-        GetPath(mmr_dir, dbPrefix, file_index)
-    );
+    auto get_path = [mmr_dir, dbPrefix](const uint32_t data_file_index) {
+        return GetPath(mmr_dir, dbPrefix, data_file_index);
+    };
+
+    AppendOnlyFile::Ptr pHashFile;
+
+    File manifest_file(GetManifestPath(mmr_dir, dbPrefix, file_index));
+    if (manifest_file.Exists()) {
+        auto manifest = HashFileManifest::Deserialize(manifest_file.ReadBytes());
+        pHashFile = AppendOnlyFile::Load(get_path, manifest.segments);
+    } else {
+        // Legacy layout: The hash file for file_index contains exactly the committed hashes.
+        // Record that in a manifest before anything gets appended to the file,
+        // so hashes appended by a commit that never gets finalized are ignored on reopen.
+        const uint64_t size = File(get_path(file_index)).GetSize();
+        HashFileManifest manifest(0, { AppendOnlyFile::Segment{ file_index, 0, size } });
+        pHashFile = AppendOnlyFile::Load(get_path, manifest.segments);
+        manifest_file.Replace(manifest.Serialized());
+    }
+
     return std::make_shared<PMMR>(
         dbPrefix,
         mmr_dir,
@@ -31,6 +73,11 @@ FilePath PMMR::GetPath(const FilePath& dir, const char prefix, const uint32_t fi
     return dir.GetChild(StringUtil::Format("{}{:0>6}.dat", prefix, file_index));
 }
 
+FilePath PMMR::GetManifestPath(const FilePath& dir, const char prefix, const uint32_t file_index)
+{
+    return dir.GetChild(StringUtil::Format("{}{:0>6}.mft", prefix, file_index));
+}
+
 LeafIndex PMMR::AddLeaf(const mmr::Leaf& leaf)
 {
     m_leafMap[leaf.GetLeafIndex()] = m_leaves.size();
@@ -40,8 +87,7 @@ LeafIndex PMMR::AddLeaf(const mmr::Leaf& leaf)
     auto rightHash = leaf.GetHash();
     auto nextIdx = leaf.GetNodeIndex().GetNext();
     while (!nextIdx.IsLeaf()) {
-        const mw::Hash leftHash = GetHash(nextIdx.GetLeftChild());
-        rightHash = MMRUtil::CalcParentHash(nextIdx, leftHash, rightHash);
+        rightHash = MMRUtil::CalcParentHash(nextIdx, GetHashView(nextIdx.GetLeftChild()), rightHash);
 
         m_pHashFile->Append(rightHash.vec());
         nextIdx = nextIdx.GetNext();
@@ -50,6 +96,24 @@ LeafIndex PMMR::AddLeaf(const mmr::Leaf& leaf)
     return leaf.GetLeafIndex();
 }
 
+void PMMR::AddLeaves(const Span<const Leaf>& leaves)
+{
+    std::vector<mw::Hash> hashes = MMRUtil::CalcAppendedHashes(*this, leaves);
+
+    for (const Leaf& leaf : leaves) {
+        m_leafMap[leaf.GetLeafIndex()] = m_leaves.size();
+        m_leaves.push_back(leaf);
+    }
+
+    std::vector<uint8_t> bytes;
+    bytes.reserve(hashes.size() * mw::Hash::size());
+    for (const mw::Hash& hash : hashes) {
+        bytes.insert(bytes.end(), hash.data(), hash.data() + hash.size());
+    }
+
+    m_pHashFile->Append(bytes);
+}
+
 Leaf PMMR::GetLeaf(const LeafIndex& idx) const
 {
     auto it = m_leafMap.find(idx);
@@ -67,13 +131,18 @@ Leaf PMMR::GetLeaf(const LeafIndex& idx) const
 }
 
 mw::Hash PMMR::GetHash(const Index& idx) const
+{
+    return GetHashView(idx).ToHash();
+}
+
+mw::HashView PMMR::GetHashView(const Index& idx) const
 {
     uint64_t pos = idx.GetPosition();
     if (m_pPruneList) {
         pos -= m_pPruneList->GetShift(idx);
     }
 
-    return mw::Hash(m_pHashFile->Read(pos * mw::Hash::size(), mw::Hash::size()));
+    return mw::HashView(m_pHashFile->ReadSpan(pos * mw::Hash::size(), mw::Hash::size()).data());
 }
 
 uint64_t PMMR::GetNumLeaves() const noexcept
@@ -113,11 +182,15 @@ void PMMR::BatchWrite(
     LOG_TRACE_F("Writing batch {} with first leaf {}", file_index, firstLeafIdx.Get());
 
     Rewind(firstLeafIdx.Get());
-    for (const Leaf& leaf : leaves) {
-        AddLeaf(leaf);
-    }
+    AddLeaves(leaves);
+
+    // Hashes are appended in place. After rewinding past previously committed hashes,
+    // which must be preserved until the database no longer references the previous file_index,
+    // only the hashes past the rewind point are written to the new data file for file_index.
+    m_pHashFile->Commit(file_index);
 
-    m_pHashFile->Commit(GetPath(m_dir, m_dbPrefix, file_index));
+    HashFileManifest manifest(0, m_pHashFile->GetSegments());
+    File(GetManifestPath(m_dir, m_dbPrefix, file_index)).Replace(manifest.Serialized());
 
     // Update database
     LeafDB(m_dbPrefix, m_pDatabase.get(), pBatch.get())
@@ -129,13 +202,43 @@ void PMMR::BatchWrite(
 
 void PMMR::Cleanup(const uint32_t current_file_index) const
 {
+    std::set<uint32_t> in_use;
+    for (const AppendOnlyFile::Segment& segment : m_pHashFile->GetSegments()) {
+        in_use.insert(segment.file_index);
+    }
+
+    // Data files referenced by the removed manifests may have been relocated away from,
+    // so they're removed too, unless the current file_index still uses them.
+    std::set<uint32_t> unused;
     uint32_t file_index = current_file_index;
     while (file_index > 0) {
-        FilePath prev_hashfile = GetPath(m_dir, m_dbPrefix, --file_index);
-        if (prev_hashfile.Exists()) {
-            prev_hashfile.Remove();
-        } else {
+        --file_index;
+
+        File prev_manifest(GetManifestPath(m_dir, m_dbPrefix, file_index));
+        const bool has_manifest = prev_manifest.Exists();
+        if (has_manifest) {
+            auto manifest = HashFileManifest::Deserialize(prev_manifest.ReadBytes());
+            for (const AppendOnlyFile::Segment& segment : manifest.segments) {
+                unused.insert(segment.file_index);
+            }
+        }
+
+        const bool has_hashfile = GetPath(m_dir, m_dbPrefix, file_index).Exists();
+        if (!has_manifest && !has_hashfile) {
             break;
         }
+
+        unused.insert(file_index);
+
+        if (has_manifest) {
+            prev_manifest.GetPath().Remove();
+        }
     }
-}
\ No newline at end of file
+
+    for (const uint32_t data_file_index : unused) {
+        FilePath hashfile = GetPath(m_dir, m_dbPrefix, data_file_index);
+        if (in_use.count(data_file_index) == 0 && hashfile.Exists()) {
+            hashfile.Remove();
+        }
+    }
+}
@@ -11,8 +11,7 @@ LeafIndex PMMRCache::AddLeaf(const Leaf& leaf)
     auto rightHash = leaf.GetHash();
     auto nextIdx = leaf.GetNodeIndex().GetNext();
     while (!nextIdx.IsLeaf()) {
-        const mw::Hash leftHash = GetHash(nextIdx.GetLeftChild());
-        rightHash = MMRUtil::CalcParentHash(nextIdx, leftHash, rightHash);
+        rightHash = MMRUtil::CalcParentHash(nextIdx, GetHashView(nextIdx.GetLeftChild()), rightHash);
 
         m_nodes.push_back(rightHash);
         nextIdx = nextIdx.GetNext();
@@ -22,6 +21,13 @@ LeafIndex PMMRCache::AddLeaf(const Leaf& leaf)
     return leaf.GetLeafIndex();
 }
 
+void PMMRCache::AddLeaves(const Span<const Leaf>& leaves)
+{
+    std::vector<mw::Hash> hashes = MMRUtil::CalcAppendedHashes(*this, leaves);
+    m_nodes.insert(m_nodes.end(), std::make_move_iterator(hashes.begin()), std::make_move_iterator(hashes.end()));
+    m_leaves.insert(m_leaves.end(), leaves.begin(), leaves.end());
+}
+
 Leaf PMMRCache::GetLeaf(const LeafIndex& leafIdx) const
 {
     if (leafIdx < m_firstLeaf) {
@@ -56,6 +62,17 @@ mw::Hash PMMRCache::GetHash(const Index& idx) const
     }
 }
 
+mw::HashView PMMRCache::GetHashView(const Index& idx) const
+{
+    if (idx < m_firstLeaf.GetPosition()) {
+        return m_pBase->GetHashView(idx);
+    } else {
+        const uint64_t vecIdx = idx.GetPosition() - m_firstLeaf.GetPosition();
+        assert(m_nodes.size() > vecIdx);
+        return m_nodes[vecIdx];
+    }
+}
+
 void PMMRCache::Rewind(const uint64_t numLeaves)
 {
     LOG_TRACE_F("Rewinding to {}", numLeaves);
@@ -90,9 +107,7 @@ void PMMRCache::BatchWrite(
 {
     LOG_TRACE_F("Writing batch {}", firstLeafIdx.Get());
     Rewind(firstLeafIdx.Get());
-    for (const Leaf& leaf : leaves) {
-        Add(leaf.vec());
-    }
+    AddLeaves(leaves);
 }
 
 void PMMRCache::Flush(const uint32_t file_index, const std::unique_ptr<mw::DBBatch>& pBatch)
@@ -12,8 +12,7 @@ PruneList::Ptr PruneList::Open(const FilePath& parent_dir, const uint32_t file_i
         bitset = BitSet::From(file.ReadBytes());
     }
 
-    uint64_t total_shift = bitset.count();
-    return std::shared_ptr<PruneList>(new PruneList(parent_dir, std::move(bitset), total_shift));
+    return std::shared_ptr<PruneList>(new PruneList(parent_dir, bitset));
 }
 
 FilePath PruneList::GetPath(const FilePath& dir, const uint32_t file_index)
@@ -25,8 +24,6 @@ uint64_t PruneList::GetShift(const Index& index) const noexcept
 {
     assert(!m_compacted.test(index.GetPosition()));
 
-    // NOTE: rank() uses an inefficient algorithm.
-    // A shift cache with an efficient "nearest-neighbor" searching algorithm would be better.
     return m_compacted.rank(index.GetPosition());
 }
 
@@ -40,6 +37,5 @@ void PruneList::Commit(const uint32_t file_index, const BitSet& compacted)
     File(GetPath(m_dir, file_index))
         .Write(compacted.bytes());
 
-    m_compacted = compacted;
-    m_totalShift = compacted.count();
+    m_compacted = RankIndexedBitSet(compacted);
 }
\ No newline at end of file
@@ -5,13 +5,26 @@
 
 void mw::Block::Validate() const
 {
-    if (m_pHeader->GetNumKernels() != m_body.GetKernels().size()) {
-        ThrowValidation(EConsensusError::MMR_MISMATCH);
+    ValidateStructure();
+
+    if (!Schnorr::BatchVerify(m_body.BuildSignedMsgs())) {
+        ThrowValidation(EConsensusError::INVALID_SIG);
     }
 
-    m_body.Validate();
+    if (!Bulletproofs::BatchVerify(m_body.BuildProofData())) {
+        ThrowValidation(EConsensusError::BULLETPROOF);
+    }
 
     StealthSumValidator::Validate(m_pHeader->GetStealthOffset(), m_body);
+}
+
+void mw::Block::ValidateStructure() const
+{
+    if (m_pHeader->GetNumKernels() != m_body.GetKernels().size()) {
+        ThrowValidation(EConsensusError::MMR_MISMATCH);
+    }
+
+    m_body.ValidateStructure();
 
     MemMMR kernel_mmr;
     std::for_each(
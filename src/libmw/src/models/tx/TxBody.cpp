@@ -61,7 +61,7 @@ int32_t TxBody::GetLockHeight() const noexcept
     );
 }
 
-void TxBody::Validate() const
+void TxBody::ValidateStructure() const
 {
     // Verify weight
     if (Weight::ExceedsMaximum(*this)) {
@@ -97,10 +97,13 @@ void TxBody::Validate() const
         ThrowValidation(EConsensusError::DUPLICATES);
     }
 
-    //
-    // Verify all signatures
-    //
+}
+
+std::vector<SignedMessage> TxBody::BuildSignedMsgs() const
+{
     std::vector<SignedMessage> signatures;
+    signatures.reserve(m_kernels.size() + m_inputs.size() + m_outputs.size());
+
     std::transform(
         m_kernels.cbegin(), m_kernels.cend(), std::back_inserter(signatures),
         [](const Kernel& kernel) { return kernel.BuildSignedMsg(); }
@@ -116,19 +119,37 @@ void TxBody::Validate() const
         [](const Output& output) { return output.BuildSignedMsg(); }
     );
 
-    if (!Schnorr::BatchVerify(signatures)) {
-        ThrowValidation(EConsensusError::INVALID_SIG);
-    }
+    return signatures;
+}
 
-    //
-    // Verify RangeProofs
-    //
+std::vector<ProofData> TxBody::BuildProofData() const
+{
     std::vector<ProofData> rangeProofs;
+    rangeProofs.reserve(m_outputs.size());
+
     std::transform(
         m_outputs.cbegin(), m_outputs.cend(), std::back_inserter(rangeProofs),
         [](const Output& output) { return output.BuildProofData(); }
     );
-    if (!Bulletproofs::BatchVerify(rangeProofs)) {
+
+    return rangeProofs;
+}
+
+void TxBody::Validate() const
+{
+    ValidateStructure();
+
+    //
+    // Verify all signatures
+    //
+    if (!Schnorr::BatchVerify(BuildSignedMsgs())) {
+        ThrowValidation(EConsensusError::INVALID_SIG);
+    }
+
+    //
+    // Verify RangeProofs
+    //
+    if (!Bulletproofs::BatchVerify(BuildProofData())) {
         ThrowValidation(EConsensusError::BULLETPROOF);
     }
 }
\ No newline at end of file
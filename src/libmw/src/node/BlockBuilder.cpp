@@ -8,7 +8,7 @@
 
 MW_NAMESPACE
 
-bool BlockBuilder::AddTransaction(const Transaction::CPtr& pTransaction, const std::vector<PegInCoin>& pegins)
+bool BlockBuilder::AddTransaction(const Transaction::CPtr& pTransaction, const std::vector<PegInCoin>& pegins, const bool validated)
 {
     // Check weight
     uint64_t weight = Weight::Calculate(pTransaction->GetBody());
@@ -52,11 +52,14 @@ bool BlockBuilder::AddTransaction(const Transaction::CPtr& pTransaction, const s
         }
     }
 
-    // Validate transaction
-    try {
-        pTransaction->Validate();
-    } catch (std::exception& e) {
-        LOG_DEBUG_F("Failed to add transaction {}. Error: {}", pTransaction, e.what());
+    // Validate transaction, unless it was already validated (e.g. by the mempool)
+    if (!validated) {
+        try {
+            pTransaction->Validate();
+        } catch (std::exception& e) {
+            LOG_ERROR_F("Failed to add transaction {}. Error: {}", pTransaction, e.what());
+            return false;
+        }
     }
 
     // Make sure all inputs are available.
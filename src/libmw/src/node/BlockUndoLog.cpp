@@ -0,0 +1,88 @@
+#include <mw/node/BlockUndoLog.h>
+
+using namespace mw;
+
+void BlockUndoLog::Add(const mw::Hash& header_hash, const mw::BlockUndo::CPtr& pUndo)
+{
+    assert(pUndo != nullptr);
+
+    if (m_undos.count(header_hash) == 0) {
+        m_order.push_back(header_hash);
+    }
+
+    m_undos[header_hash] = pUndo;
+    m_pSnapshot.reset();
+
+    while (m_order.size() > m_maxBlocks) {
+        m_undos.erase(m_order.front());
+        m_order.pop_front();
+    }
+}
+
+void BlockUndoLog::Clear() noexcept
+{
+    m_order.clear();
+    m_undos.clear();
+    m_pSnapshot.reset();
+}
+
+mw::CoinsViewCache::Ptr BlockUndoLog::Snapshot(
+    const mw::ICoinsView::Ptr& pTip,
+    const mw::Hash& header_hash,
+    const ReadUndoFn& read_undo)
+{
+    assert(pTip != nullptr);
+
+    mw::Header::CPtr pHeader = pTip->GetBestHeader();
+    if (pHeader == nullptr) {
+        return nullptr;
+    }
+
+    if (m_pSnapshot != nullptr && m_pSnapshotTip == pTip && m_snapshotTipHash == pHeader->GetHash() && m_snapshotHash == header_hash) {
+        return m_pSnapshot;
+    }
+
+    const mw::Hash tip_hash = pHeader->GetHash();
+
+    // Look up all the undo data before adding any of it, since adding resets the cached snapshot.
+    std::vector<mw::BlockUndo::CPtr> undos;
+    std::vector<std::pair<mw::Hash, mw::BlockUndo::CPtr>> loaded;
+    while (pHeader->GetHash() != header_hash) {
+        mw::BlockUndo::CPtr pUndo;
+        auto iter = m_undos.find(pHeader->GetHash());
+        if (iter != m_undos.end()) {
+            pUndo = iter->second;
+        } else if (read_undo && undos.size() < m_maxBlocks) {
+            pUndo = read_undo(pHeader->GetHash());
+            if (pUndo != nullptr) {
+                loaded.push_back({ pHeader->GetHash(), pUndo });
+            }
+        }
+
+        if (pUndo == nullptr) {
+            return nullptr;
+        }
+
+        undos.push_back(pUndo);
+
+        pHeader = pUndo->GetPreviousHeader();
+        if (pHeader == nullptr) {
+            return nullptr;
+        }
+    }
+
+    for (const auto& entry : loaded) {
+        Add(entry.first, entry.second);
+    }
+
+    auto pSnapshot = std::make_shared<mw::CoinsViewCache>(pTip);
+    for (const mw::BlockUndo::CPtr& pUndo : undos) {
+        pSnapshot->UndoBlock(pUndo);
+    }
+
+    m_pSnapshotTip = pTip;
+    m_snapshotTipHash = tip_hash;
+    m_snapshotHash = header_hash;
+    m_pSnapshot = pSnapshot;
+    return pSnapshot;
+}
\ No newline at end of file
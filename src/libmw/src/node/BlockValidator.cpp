@@ -1,4 +1,8 @@
 #include <mw/node/BlockValidator.h>
+#include <mw/consensus/KernelSumValidator.h>
+#include <mw/consensus/StealthSumValidator.h>
+#include <mw/crypto/Bulletproofs.h>
+#include <mw/crypto/Schnorr.h>
 #include <mw/exceptions/ValidationException.h>
 #include <set>
 #include <unordered_map>
@@ -23,6 +27,133 @@ bool BlockValidator::ValidateBlock(
     return false;
 }
 
+BlockValidator::Check BlockValidator::Check::Signatures(std::vector<SignedMessage>&& batch)
+{
+    Check check;
+    check.m_type = Type::SIGNATURES;
+    check.m_signatures = std::move(batch);
+    return check;
+}
+
+BlockValidator::Check BlockValidator::Check::RangeProofs(std::vector<ProofData>&& batch)
+{
+    Check check;
+    check.m_type = Type::RANGEPROOFS;
+    check.m_proofs = std::move(batch);
+    return check;
+}
+
+BlockValidator::Check BlockValidator::Check::StealthSum(const mw::Block::CPtr& pBlock)
+{
+    Check check;
+    check.m_type = Type::STEALTH_SUM;
+    check.m_pBlock = pBlock;
+    return check;
+}
+
+BlockValidator::Check BlockValidator::Check::KernelSum(const mw::Block::CPtr& pBlock, const BlindingFactor& prev_kernel_offset)
+{
+    Check check;
+    check.m_type = Type::KERNEL_SUM;
+    check.m_pBlock = pBlock;
+    check.m_prevKernelOffset = prev_kernel_offset;
+    return check;
+}
+
+bool BlockValidator::Check::operator()() const noexcept
+{
+    try {
+        switch (m_type) {
+            case Type::NONE:
+                return true;
+            case Type::SIGNATURES:
+                if (!Schnorr::BatchVerify(m_signatures)) {
+                    ThrowValidation(EConsensusError::INVALID_SIG);
+                }
+                return true;
+            case Type::RANGEPROOFS:
+                if (!Bulletproofs::BatchVerify(m_proofs)) {
+                    ThrowValidation(EConsensusError::BULLETPROOF);
+                }
+                return true;
+            case Type::STEALTH_SUM:
+                StealthSumValidator::Validate(m_pBlock->GetHeader()->GetStealthOffset(), m_pBlock->GetTxBody());
+                return true;
+            case Type::KERNEL_SUM:
+                KernelSumValidator::ValidateForBlock(m_pBlock->GetTxBody(), m_pBlock->GetKernelOffset(), m_prevKernelOffset);
+                return true;
+        }
+    } catch (const std::exception& e) {
+        LOG_ERROR_F("Block check failed. Error: {}", e);
+    }
+
+    return false;
+}
+
+bool BlockValidator::ValidateStructure(
+    const mw::Block::CPtr& pBlock,
+    const std::vector<PegInCoin>& pegInCoins,
+    const std::vector<PegOutCoin>& pegOutCoins) noexcept
+{
+    assert(pBlock != nullptr);
+
+    try {
+        pBlock->ValidateStructure();
+
+        ValidatePegInCoins(pBlock, pegInCoins);
+        ValidatePegOutCoins(pBlock, pegOutCoins);
+        return true;
+    } catch (const std::exception& e) {
+        LOG_ERROR_F("Failed to validate {}. Error: {}", *pBlock, e);
+    }
+
+    return false;
+}
+
+// Batch verification gets cheaper per item as batches grow, so avoid splitting into batches smaller than these.
+static constexpr size_t MIN_SIGNATURES_PER_BATCH = 64;
+static constexpr size_t MIN_PROOFS_PER_BATCH = 8;
+
+template<typename T, typename F>
+static void AddBatchChecks(
+    std::vector<T>&& items,
+    const size_t num_batches,
+    const size_t min_batch_size,
+    const F& make_check,
+    std::vector<BlockValidator::Check>& checks)
+{
+    if (items.empty()) {
+        return;
+    }
+
+    const size_t max_batches = std::max<size_t>(1, items.size() / min_batch_size);
+    const size_t batches = std::max<size_t>(1, std::min(num_batches, max_batches));
+    const size_t batch_size = (items.size() + batches - 1) / batches;
+
+    for (size_t begin = 0; begin < items.size(); begin += batch_size) {
+        const size_t end = std::min(items.size(), begin + batch_size);
+        checks.push_back(make_check(std::vector<T>(
+            std::make_move_iterator(items.begin() + begin),
+            std::make_move_iterator(items.begin() + end)
+        )));
+    }
+}
+
+std::vector<BlockValidator::Check> BlockValidator::BuildChecks(
+    const mw::Block::CPtr& pBlock,
+    const BlindingFactor& prev_kernel_offset,
+    const size_t num_batches)
+{
+    assert(pBlock != nullptr);
+
+    std::vector<Check> checks;
+    AddBatchChecks(pBlock->GetTxBody().BuildSignedMsgs(), num_batches, MIN_SIGNATURES_PER_BATCH, &Check::Signatures, checks);
+    AddBatchChecks(pBlock->GetTxBody().BuildProofData(), num_batches, MIN_PROOFS_PER_BATCH, &Check::RangeProofs, checks);
+    checks.push_back(Check::StealthSum(pBlock));
+    checks.push_back(Check::KernelSum(pBlock, prev_kernel_offset));
+    return checks;
+}
+
 void BlockValidator::ValidatePegInCoins(
     const mw::Block::CPtr& pBlock,
     const std::vector<PegInCoin>& pegInCoins)
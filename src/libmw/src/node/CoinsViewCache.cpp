@@ -4,11 +4,38 @@
 #include <mw/consensus/KernelSumValidator.h>
 #include <mw/common/Logger.h>
 #include <mw/db/MMRInfoDB.h>
+#include <mw/db/ProofDB.h>
+#include <mw/exceptions/DatabaseException.h>
 
 #include "CoinActions.h"
+#include <unordered_set>
 
 using namespace mw;
 
+UTXO::CPtr ICoinsView::GetUTXOWithProof(const mw::Hash& output_id) const
+{
+    UTXO::CPtr pUTXO = GetUTXO(output_id);
+    if (pUTXO == nullptr || pUTXO->HasRangeProof()) {
+        return pUTXO;
+    }
+
+    return std::make_shared<UTXO>(LoadRangeProof(*pUTXO));
+}
+
+UTXO ICoinsView::LoadRangeProof(const UTXO& utxo) const
+{
+    if (utxo.HasRangeProof()) {
+        return utxo;
+    }
+
+    RangeProof::CPtr pProof = ProofDB(GetDatabase().get(), nullptr).Get(utxo.GetLeafIndex());
+    if (pProof == nullptr || pProof->GetHash() != utxo.GetRangeProofHash()) {
+        ThrowDatabase_F("Rangeproof missing for MWEB UTXO {}", utxo.GetOutputID().ToHex());
+    }
+
+    return utxo.WithRangeProof(pProof);
+}
+
 CoinsViewCache::CoinsViewCache(const ICoinsView::Ptr& pBase)
     : ICoinsView(pBase->GetBestHeader(), pBase->GetDatabase()),
       m_pBase(pBase),
@@ -34,30 +61,33 @@ UTXO::CPtr CoinsViewCache::GetUTXO(const mw::Hash& output_id) const noexcept
     return pUTXO;
 }
 
-mw::BlockUndo::CPtr CoinsViewCache::ApplyBlock(const mw::Block::CPtr& pBlock)
+mw::BlockUndo::CPtr CoinsViewCache::ApplyBlock(const mw::Block::CPtr& pBlock, const bool check_kernel_sum)
 {
     assert(pBlock != nullptr);
 
     auto pPreviousHeader = GetBestHeader();
+    if (check_kernel_sum) {
+        BlindingFactor prev_offset = pPreviousHeader != nullptr ? pPreviousHeader->GetKernelOffset() : BlindingFactor();
+        KernelSumValidator::ValidateForBlock(pBlock->GetTxBody(), pBlock->GetKernelOffset(), prev_offset);
+    }
+
     SetBestHeader(pBlock->GetHeader());
 
-    BlindingFactor prev_offset = pPreviousHeader != nullptr ? pPreviousHeader->GetKernelOffset() : BlindingFactor();
-    KernelSumValidator::ValidateForBlock(pBlock->GetTxBody(), pBlock->GetKernelOffset(), prev_offset);
+    AddUTXOs(pBlock->GetHeight(), pBlock->GetOutputs());
 
     std::vector<mw::Hash> coinsAdded;
-    std::for_each(
+    std::transform(
         pBlock->GetOutputs().cbegin(), pBlock->GetOutputs().cend(),
-        [this, &pBlock, &coinsAdded](const Output& output) {
-            AddUTXO(pBlock->GetHeight(), output);
-            coinsAdded.push_back(output.GetOutputID());
-        }
+        std::back_inserter(coinsAdded),
+        [](const Output& output) { return output.GetOutputID(); }
     );
 
     std::vector<UTXO> coinsSpent;
     std::for_each(
         pBlock->GetInputs().cbegin(), pBlock->GetInputs().cend(),
         [this, &coinsSpent](const Input& input) {
-            UTXO spentUTXO = SpendUTXO(input.GetOutputID());
+            // The undo data holds the full outputs, so they can be added back to the coins database with their rangeproofs.
+            UTXO spentUTXO = LoadRangeProof(SpendUTXO(input.GetOutputID()));
             coinsSpent.push_back(std::move(spentUTXO));
         }
     );
@@ -139,10 +169,7 @@ mw::Block::Ptr CoinsViewCache::BuildNextBlock(const uint64_t height, const std::
         [&pKernelMMR](const Kernel& kernel) { pKernelMMR->Add(kernel); }
     );
 
-    std::for_each(
-        pTransaction->GetOutputs().cbegin(), pTransaction->GetOutputs().cend(),
-        [this, height](const Output& output) { AddUTXO(height, output); }
-    );
+    AddUTXOs(height, pTransaction->GetOutputs());
 
     std::for_each(
         pTransaction->GetInputs().cbegin(), pTransaction->GetInputs().cend(),
@@ -215,6 +242,30 @@ void CoinsViewCache::AddUTXO(const uint64_t header_height, const Output& output)
     m_pUpdates->AddUTXO(pUTXO);
 }
 
+void CoinsViewCache::AddUTXOs(const uint64_t header_height, const std::vector<Output>& outputs)
+{
+    std::unordered_set<mw::Hash> output_ids;
+    std::vector<mmr::Leaf> leaves;
+    leaves.reserve(outputs.size());
+
+    mmr::LeafIndex leafIdx = m_pOutputPMMR->GetNextLeafIdx();
+    for (const Output& output : outputs) {
+        if (!output_ids.insert(output.GetOutputID()).second || GetUTXO(output.GetOutputID()) != nullptr) {
+            ThrowValidation(EConsensusError::DUPLICATES);
+        }
+
+        leaves.push_back(mmr::Leaf::Create(leafIdx, output.GetOutputID().Serialized()));
+        leafIdx = leafIdx.Next();
+    }
+
+    m_pOutputPMMR->AddLeaves(leaves);
+
+    for (size_t i = 0; i < outputs.size(); i++) {
+        m_pLeafSet->Add(leaves[i].GetLeafIndex());
+        m_pUpdates->AddUTXO(std::make_shared<UTXO>(header_height, leaves[i].GetLeafIndex(), outputs[i]));
+    }
+}
+
 UTXO CoinsViewCache::SpendUTXO(const mw::Hash& output_id)
 {
     UTXO::CPtr pUTXO = GetUTXO(output_id);
@@ -1,11 +1,16 @@
 #include <mw/node/CoinsView.h>
 
+#include <mw/common/Logger.h>
 #include <mw/db/CoinDB.h>
 #include <mw/db/MMRInfoDB.h>
+#include <mw/db/ProofDB.h>
+#include <mw/exceptions/DatabaseException.h>
 #include <mw/exceptions/ValidationException.h>
 #include <mw/mmr/PruneList.h>
 
 #include "CoinActions.h"
+#include <map>
+#include <set>
 
 using namespace mw;
 
@@ -14,6 +19,21 @@ CoinsViewDB::Ptr CoinsViewDB::Open(
     const mw::Header::CPtr& pBestHeader,
     const mw::DBWrapper::Ptr& pDBWrapper)
 {
+    if (pDBWrapper != nullptr) {
+        CoinDB coinDB(pDBWrapper.get(), nullptr);
+        const uint32_t version = coinDB.GetVersion();
+        if (version > CoinDB::CURRENT_VERSION) {
+            ThrowDatabase_F("MWEB coin database version {} is newer than the supported version {}", version, CoinDB::CURRENT_VERSION);
+        }
+
+        if (version < CoinDB::CURRENT_VERSION) {
+            const size_t num_migrated = coinDB.MigrateLegacyUTXOs();
+            if (num_migrated > 0) {
+                LOG_INFO_F("Migrated {} MWEB coins to the compact format", num_migrated);
+            }
+        }
+    }
+
     auto current_mmr_info = MMRInfoDB(pDBWrapper.get(), nullptr).GetLatest();
     uint32_t file_index = current_mmr_info ? current_mmr_info->index : 0;
     uint32_t compact_index = current_mmr_info ? current_mmr_info->compact_index : 0;
@@ -58,32 +78,63 @@ void CoinsViewDB::AddUTXO(CoinDB& coinDB, const UTXO::CPtr& pUTXO)
     coinDB.AddUTXOs(std::vector<UTXO::CPtr>{ pUTXO });
 }
 
-void CoinsViewDB::SpendUTXO(CoinDB& coinDB, const mw::Hash& output_id)
-{
-    UTXO::CPtr pUTXO = GetUTXO(coinDB, output_id);
-    if (pUTXO == nullptr) {
-		ThrowValidation(EConsensusError::UTXO_MISSING);
-    }
-
-    coinDB.RemoveUTXOs(std::vector<mw::Hash>{output_id});
-}
-
 void CoinsViewDB::WriteBatch(const std::unique_ptr<mw::DBBatch>& pBatch, const CoinsViewUpdates& updates, const mw::Header::CPtr& pHeader)
 {
     assert(pBatch != nullptr);
     SetBestHeader(pHeader);
 
     CoinDB coinDB(GetDatabase().get(), pBatch.get());
+
+    // Look up all of the coins being spent at once, rather than one at a time.
+    std::vector<mw::Hash> spent_ids;
+    for (const auto& actions : updates.GetActions()) {
+        if (!actions.second.empty() && actions.second.front().IsSpend()) {
+            spent_ids.push_back(actions.first);
+        }
+    }
+
+    auto existing_utxos = coinDB.GetUTXOs(spent_ids);
+
+    // Rangeproofs are keyed by leaf index, which gets reused when blocks are disconnected.
+    // Since the actions are grouped by output ID rather than ordered in time, the proofs
+    // to keep are only known once all of the actions have been applied.
+    std::map<mmr::LeafIndex, RangeProof::CPtr> proofs_added;
+    std::set<mmr::LeafIndex> proofs_removed;
+
     for (const auto& actions : updates.GetActions()) {
         const mw::Hash& output_id = actions.first;
+        auto existing_iter = existing_utxos.find(output_id);
+        UTXO::CPtr pExisting = existing_iter != existing_utxos.end() ? existing_iter->second : nullptr;
         for (const auto& action : actions.second) {
             if (action.IsSpend()) {
-                SpendUTXO(coinDB, output_id);
+                if (pExisting == nullptr) {
+                    ThrowValidation(EConsensusError::UTXO_MISSING);
+                }
+
+                coinDB.RemoveUTXOs(std::vector<mw::Hash>{output_id});
+                proofs_removed.insert(pExisting->GetLeafIndex());
+                pExisting = nullptr;
             } else {
+                assert(action.pUTXO->HasRangeProof());
                 AddUTXO(coinDB, action.pUTXO);
+                pExisting = action.pUTXO;
             }
         }
+
+        if (pExisting != nullptr && pExisting->HasRangeProof()) {
+            proofs_added[pExisting->GetLeafIndex()] = pExisting->GetRangeProof();
+        }
     }
+
+    ProofDB proofDB(GetDatabase().get(), pBatch.get());
+
+    std::vector<mmr::LeafIndex> to_remove;
+    std::copy_if(
+        proofs_removed.cbegin(), proofs_removed.cend(), std::back_inserter(to_remove),
+        [&proofs_added](const mmr::LeafIndex& idx) { return proofs_added.count(idx) == 0; }
+    );
+    proofDB.Remove(to_remove);
+    proofDB.Add(std::vector<std::pair<mmr::LeafIndex, RangeProof::CPtr>>(proofs_added.cbegin(), proofs_added.cend()));
 }
 
 void CoinsViewDB::Compact() const
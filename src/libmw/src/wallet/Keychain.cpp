@@ -9,17 +9,27 @@ MW_NAMESPACE
 
 bool Keychain::RewindOutput(const Output& output, mw::Coin& coin) const
 {
-    if (!output.HasStandardFields()) {
+    PublicKey shared_secret;
+    if (!CheckViewTag(output, shared_secret)) {
         return false;
     }
 
-    assert(!GetScanSecret().IsNull());
-    PublicKey shared_secret = output.Ke().Mul(GetScanSecret());
-    uint8_t view_tag = Hashed(EHashTag::TAG, shared_secret)[0];
-    if (view_tag != output.GetViewTag()) {
+    return RewindOutput(output, shared_secret, coin);
+}
+
+bool Keychain::CheckViewTag(const Output& output, PublicKey& shared_secret) const
+{
+    if (!output.HasStandardFields()) {
         return false;
     }
 
+    assert(!GetScanSecret().IsNull());
+    shared_secret = output.Ke().Mul(GetScanSecret());
+    return Hashed(EHashTag::TAG, shared_secret)[0] == output.GetViewTag();
+}
+
+bool Keychain::RewindOutput(const Output& output, const PublicKey& shared_secret, mw::Coin& coin) const
+{
     SecretKey t = Hashed(EHashTag::DERIVE, shared_secret);
     PublicKey B_i = output.Ko().Div(Hashed(EHashTag::OUT_KEY, t));
 
@@ -6,6 +6,8 @@
 #include <mw/crypto/PublicKeys.h>
 #include <mw/crypto/Schnorr.h>
 
+#include <random.h>
+
 #include <test_framework/TestMWEB.h>
 
 BOOST_FIXTURE_TEST_SUITE(TestAggSig, MWEBTestingSetup)
@@ -94,4 +96,45 @@ BOOST_AUTO_TEST_CASE(SingleSchnorrSig)
     BOOST_REQUIRE(valid == true);
 }
 
+BOOST_AUTO_TEST_CASE(VerificationCacheSetup)
+{
+    const uint256 entry = GetRandHash();
+
+    // The cache stays disabled until it's set up from init
+    VerificationCache cache;
+    cache.Insert(entry);
+    BOOST_REQUIRE(!cache.Contains(entry, false));
+    BOOST_REQUIRE(cache.GetStats().max_elements == 0);
+
+    BOOST_REQUIRE(cache.Setup(GetRandHash(), 1 << 16) > 0);
+    cache.Insert(entry);
+    BOOST_REQUIRE(cache.Contains(entry, false));
+    BOOST_REQUIRE(cache.GetStats().hits == 1);
+    BOOST_REQUIRE(cache.GetStats().misses == 1);
+}
+
+BOOST_AUTO_TEST_CASE(SchnorrVerificationCache)
+{
+    SecretKey secretKey = SecretKey::Random();
+    SignedMessage signed_message = Schnorr::SignMessage(secretKey, SecretKey::Random().GetBigInt());
+
+    // First verification misses the cache
+    VerificationCache::Stats before = Schnorr::GetCacheStats();
+    BOOST_REQUIRE(Schnorr::BatchVerify({ signed_message }));
+    VerificationCache::Stats after_first = Schnorr::GetCacheStats();
+    BOOST_REQUIRE(after_first.misses == before.misses + 1);
+    BOOST_REQUIRE(after_first.hits == before.hits);
+
+    // Second verification is served by the cache
+    BOOST_REQUIRE(Schnorr::BatchVerify({ signed_message }));
+    BOOST_REQUIRE(Schnorr::Verify(signed_message.GetSignature(), signed_message.GetPublicKey(), signed_message.GetMsgHash()));
+    VerificationCache::Stats after_second = Schnorr::GetCacheStats();
+    BOOST_REQUIRE(after_second.hits == after_first.hits + 2);
+    BOOST_REQUIRE(after_second.misses == after_first.misses);
+
+    // A signature over a different message must not match the cached entry
+    SignedMessage tampered(SecretKey::Random().GetBigInt(), signed_message.GetPublicKey(), signed_message.GetSignature());
+    BOOST_REQUIRE(!Schnorr::BatchVerify({ tampered }));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
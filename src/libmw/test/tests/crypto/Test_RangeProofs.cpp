@@ -3,9 +3,37 @@
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
 #include <mw/crypto/Bulletproofs.h>
+#include <libmw/src/crypto/ScratchSpace.h>
 
 #include <test_framework/TestMWEB.h>
 
+static ProofData GenerateProof(const uint64_t value)
+{
+    BlindingFactor blind = BlindingFactor::Random();
+    SecretKey nonce = SecretKey::Random();
+    std::vector<uint8_t> extraData = secret_key_t<100>::Random().vec();
+    RangeProof::CPtr pRangeProof = Bulletproofs::Generate(
+        value,
+        SecretKey(blind.vec()),
+        nonce,
+        nonce,
+        secret_key_t<20>::Random().GetBigInt(),
+        extraData
+    );
+    return ProofData{ Commitment::Blinded(blind, value), pRangeProof, extraData };
+}
+
+// Overwrites the x coordinate of the proof's first point. About half of the values aren't on the curve,
+// which makes secp256k1 reject the proof before it has released its scratch space frames.
+static ProofData CorruptProof(const ProofData& proof, const uint8_t x)
+{
+    std::vector<uint8_t> bytes(proof.pRangeProof->data(), proof.pRangeProof->data() + proof.pRangeProof->size());
+    std::fill(bytes.begin() + 65, bytes.begin() + 97, 0);
+    bytes[96] = x;
+
+    return ProofData{ proof.commitment, std::make_shared<RangeProof>(std::move(bytes)), proof.extraData };
+}
+
 BOOST_FIXTURE_TEST_SUITE(TestRangeProofs, MWEBTestingSetup)
 
 BOOST_AUTO_TEST_CASE(RangeProofs)
@@ -48,4 +76,38 @@ BOOST_AUTO_TEST_CASE(RangeProofs)
     BOOST_REQUIRE(Bulletproofs::BatchVerify(rangeProofs));
 }
 
+BOOST_AUTO_TEST_CASE(CorruptRangeProofs)
+{
+    const ProofData proof = GenerateProof(100);
+    for (uint8_t i = 0; i < 16; i++) {
+        std::vector<ProofData> corrupt{ CorruptProof(proof, i) };
+        BOOST_REQUIRE(!Bulletproofs::BatchVerify(corrupt));
+    }
+
+    // Valid proofs still verify afterwards.
+    std::vector<ProofData> valid{ GenerateProof(200), GenerateProof(300) };
+    BOOST_REQUIRE(Bulletproofs::BatchVerify(valid));
+}
+
+BOOST_AUTO_TEST_CASE(ScratchSpaceReuse)
+{
+    // Each proof is new, so none of them are served by the verification cache.
+    std::vector<ProofData> proofs;
+    for (uint64_t i = 0; i < 3; i++) {
+        proofs.push_back(GenerateProof(1000 + i));
+    }
+
+    // A rejected batch discards the thread's scratch space, which may have been left with frames allocated.
+    std::vector<ProofData> corrupt{ CorruptProof(proofs[0], 0) };
+    BOOST_REQUIRE(!Bulletproofs::BatchVerify(corrupt));
+
+    // The next verification creates a fresh one, which later verifications on this thread reuse.
+    const uint64_t num_created = ScratchSpace::NumCreated().load();
+    BOOST_REQUIRE(Bulletproofs::BatchVerify({ proofs[0] }));
+    BOOST_REQUIRE(ScratchSpace::NumCreated().load() == num_created + 1);
+    BOOST_REQUIRE(Bulletproofs::BatchVerify({ proofs[1] }));
+    BOOST_REQUIRE(Bulletproofs::BatchVerify({ proofs[2] }));
+    BOOST_REQUIRE(ScratchSpace::NumCreated().load() == num_created + 1);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
@@ -0,0 +1,179 @@
+// Copyright (c) 2021 The Litecoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <mw/db/CoinDB.h>
+#include <mw/db/MMRInfoDB.h>
+#include <mw/db/ProofDB.h>
+#include <mw/exceptions/DatabaseException.h>
+#include <mw/models/wallet/StealthAddress.h>
+#include <mw/node/CoinsView.h>
+
+#include <test_framework/TestMWEB.h>
+
+BOOST_FIXTURE_TEST_SUITE(TestCoinDB, MWEBTestingSetup)
+
+static UTXO::CPtr CreateUTXO(const uint64_t leaf_idx)
+{
+    BlindingFactor blind;
+    Output output = Output::Create(&blind, SecretKey::Random(), StealthAddress::Random(), 1000 + leaf_idx);
+    return std::make_shared<UTXO>(10, mmr::LeafIndex::At(leaf_idx), std::move(output));
+}
+
+BOOST_AUTO_TEST_CASE(CoinDBTest)
+{
+    auto pDatabase = GetDB();
+
+    std::vector<UTXO::CPtr> utxos;
+    for (uint64_t i = 0; i < 5; i++) {
+        utxos.push_back(CreateUTXO(i));
+    }
+
+    CoinDB(pDatabase.get()).AddUTXOs(utxos);
+
+    // Coins are keyed by the raw output ID, and stored without their rangeproofs
+    std::vector<uint8_t> data;
+    const mw::Hash& output_id0 = utxos[0]->GetOutputID();
+    BOOST_REQUIRE(pDatabase->Read("C" + std::string((const char*)output_id0.data(), output_id0.size()), data));
+    BOOST_REQUIRE(data == CompactUTXO(utxos[0]).Serialized());
+
+    // Batched lookup, including missing and duplicate output IDs
+    const mw::Hash missing_id = SecretKey::Random().GetBigInt();
+    auto found = CoinDB(pDatabase.get()).GetUTXOs({
+        utxos[4]->GetOutputID(),
+        missing_id,
+        utxos[1]->GetOutputID(),
+        utxos[4]->GetOutputID(),
+        utxos[2]->GetOutputID()
+    });
+    BOOST_REQUIRE(found.size() == 3);
+    BOOST_REQUIRE(found[utxos[1]->GetOutputID()]->GetLeafIndex() == utxos[1]->GetLeafIndex());
+    BOOST_REQUIRE(found[utxos[2]->GetOutputID()]->GetLeafIndex() == utxos[2]->GetLeafIndex());
+    BOOST_REQUIRE(found[utxos[4]->GetOutputID()]->GetLeafIndex() == utxos[4]->GetLeafIndex());
+
+    // Batched lookup within a pending batch sees uncommitted coins
+    {
+        auto pBatch = pDatabase->CreateBatch();
+        CoinDB batchDB(pDatabase.get(), pBatch.get());
+
+        UTXO::CPtr pPending = CreateUTXO(5);
+        batchDB.AddUTXOs({ pPending });
+        auto pending = batchDB.GetUTXOs({ pPending->GetOutputID(), utxos[3]->GetOutputID() });
+        BOOST_REQUIRE(pending.size() == 2);
+    }
+
+    CoinDB(pDatabase.get()).RemoveUTXOs({ utxos[1]->GetOutputID() });
+    BOOST_REQUIRE(CoinDB(pDatabase.get()).GetUTXOs({ utxos[1]->GetOutputID(), utxos[2]->GetOutputID() }).size() == 1);
+}
+
+BOOST_AUTO_TEST_CASE(CoinDBMigrateLegacyUTXOs)
+{
+    auto pDatabase = GetDB();
+
+    // Full UTXOs, under both the hex-encoded and the raw output ID keys
+    std::vector<UTXO::CPtr> utxos;
+    {
+        auto pBatch = pDatabase->CreateBatch();
+        for (uint64_t i = 0; i < 4; i++) {
+            utxos.push_back(CreateUTXO(i));
+            const mw::Hash& output_id = utxos.back()->GetOutputID();
+            const std::string key = i % 2 == 0 ? output_id.ToHex() : std::string((const char*)output_id.data(), output_id.size());
+            pBatch->Write("U" + key, utxos.back()->Serialized());
+        }
+        pBatch->Commit();
+    }
+
+    // Entries of other tables, with shorter keys, sort between the legacy keys in the database.
+    MMRInfoDB(pDatabase.get()).Save(MMRInfo());
+    CoinDB(pDatabase.get()).AddUTXOs({ CreateUTXO(4) });
+
+    BOOST_REQUIRE(CoinDB(pDatabase.get()).GetUTXOs({ utxos[0]->GetOutputID() }).empty());
+    BOOST_REQUIRE(CoinDB(pDatabase.get()).GetVersion() == 0);
+
+    BOOST_REQUIRE(CoinDB(pDatabase.get()).MigrateLegacyUTXOs() == 4);
+    BOOST_REQUIRE(CoinDB(pDatabase.get()).GetVersion() == CoinDB::CURRENT_VERSION);
+    BOOST_REQUIRE(CoinDB(pDatabase.get()).MigrateLegacyUTXOs() == 0);
+
+    std::vector<uint8_t> data;
+    BOOST_REQUIRE(!pDatabase->Read("U" + utxos[0]->GetOutputID().ToHex(), data));
+
+    auto found = CoinDB(pDatabase.get()).GetUTXOs({
+        utxos[0]->GetOutputID(),
+        utxos[1]->GetOutputID(),
+        utxos[2]->GetOutputID(),
+        utxos[3]->GetOutputID()
+    });
+    BOOST_REQUIRE(found.size() == 4);
+    for (const UTXO::CPtr& pUTXO : utxos) {
+        const UTXO::CPtr& pFound = found[pUTXO->GetOutputID()];
+        BOOST_REQUIRE(!pFound->HasRangeProof());
+
+        RangeProof::CPtr pProof = ProofDB(pDatabase.get()).Get(pFound->GetLeafIndex());
+        BOOST_REQUIRE(pProof != nullptr);
+        BOOST_REQUIRE(pFound->WithRangeProof(pProof).GetOutput() == pUTXO->GetOutput());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(CoinDBVersion)
+{
+    auto pDatabase = GetDB();
+
+    mw::CoinsViewDB::Open(GetDataDir(), nullptr, pDatabase);
+    BOOST_REQUIRE(CoinDB(pDatabase.get()).GetVersion() == CoinDB::CURRENT_VERSION);
+
+    // A database written by a newer binary must not be opened.
+    {
+        auto pBatch = pDatabase->CreateBatch();
+        pBatch->Write("V", { CoinDB::CURRENT_VERSION + 1, 0, 0, 0 });
+        pBatch->Commit();
+    }
+
+    BOOST_REQUIRE(CoinDB(pDatabase.get()).GetVersion() == CoinDB::CURRENT_VERSION + 1);
+    BOOST_REQUIRE_THROW(mw::CoinsViewDB::Open(GetDataDir(), nullptr, pDatabase), DatabaseException);
+}
+
+BOOST_AUTO_TEST_CASE(CoinDBCursor)
+{
+    auto pDatabase = GetDB();
+
+    // Entries of other tables, with shorter keys, sort before the UTXOs in the database.
+    MMRInfoDB(pDatabase.get()).Save(MMRInfo());
+
+    std::set<mw::Hash> output_ids;
+    std::vector<UTXO::CPtr> utxos;
+    for (uint64_t i = 0; i < 3; i++) {
+        utxos.push_back(CreateUTXO(i));
+        output_ids.insert(utxos.back()->GetOutputID());
+    }
+    CoinDB(pDatabase.get()).AddUTXOs(utxos);
+
+    std::set<mw::Hash> found;
+    for (auto pCursor = CoinDB(pDatabase.get()).NewCursor(); pCursor->Valid(); pCursor->Next()) {
+        UTXO::CPtr pUTXO = pCursor->GetUTXO();
+        BOOST_REQUIRE(pUTXO != nullptr);
+        found.insert(pUTXO->GetOutputID());
+    }
+    BOOST_REQUIRE(found == output_ids);
+}
+
+BOOST_AUTO_TEST_CASE(CoinDBRemoveAll)
+{
+    auto pDatabase = GetDB();
+
+    // Entries of other tables, with shorter keys, sort before the UTXOs in the database.
+    MMRInfoDB(pDatabase.get()).Save(MMRInfo());
+
+    std::vector<UTXO::CPtr> utxos;
+    for (uint64_t i = 0; i < 3; i++) {
+        utxos.push_back(CreateUTXO(i));
+    }
+    CoinDB(pDatabase.get()).AddUTXOs(utxos);
+    BOOST_REQUIRE(CoinDB(pDatabase.get()).NewCursor()->Valid());
+
+    CoinDB(pDatabase.get()).RemoveAllUTXOs();
+    BOOST_REQUIRE(!CoinDB(pDatabase.get()).NewCursor()->Valid());
+    BOOST_REQUIRE(CoinDB(pDatabase.get()).GetUTXOs({ utxos[0]->GetOutputID(), utxos[2]->GetOutputID() }).empty());
+    BOOST_REQUIRE(MMRInfoDB(pDatabase.get()).GetLatest() != nullptr);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
@@ -55,4 +55,24 @@ BOOST_AUTO_TEST_CASE(LeafDBTest)
     BOOST_REQUIRE(pLeaf->vec() == leaf2.vec());
 }
 
+BOOST_AUTO_TEST_CASE(LeafDBRemoveAll)
+{
+    auto pDatabase = GetDB();
+
+    // Keys are the decimal leaf indices, so these are stored apart from each other, by key length.
+    std::vector<mmr::Leaf> leaves;
+    for (const uint64_t idx : std::vector<uint64_t>{ 7, 42, 12345, 9876543210 }) {
+        leaves.push_back(mmr::Leaf::Create(mmr::LeafIndex::At(idx), { 1, 2, 3 }));
+    }
+
+    LeafDB('L', pDatabase.get()).Add(leaves);
+    LeafDB('M', pDatabase.get()).Add(leaves);
+
+    LeafDB('L', pDatabase.get()).RemoveAll();
+    for (const mmr::Leaf& leaf : leaves) {
+        BOOST_REQUIRE(LeafDB('L', pDatabase.get()).Get(leaf.GetLeafIndex()) == nullptr);
+        BOOST_REQUIRE(LeafDB('M', pDatabase.get()).Get(leaf.GetLeafIndex()) != nullptr);
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
@@ -0,0 +1,61 @@
+// Copyright (c) 2021 The Litecoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <mw/db/ProofDB.h>
+#include <mw/models/tx/Output.h>
+#include <mw/models/wallet/StealthAddress.h>
+
+#include <test_framework/TestMWEB.h>
+
+BOOST_FIXTURE_TEST_SUITE(TestProofDB, MWEBTestingSetup)
+
+static RangeProof::CPtr CreateProof(const uint64_t amount)
+{
+    BlindingFactor blind;
+    return Output::Create(&blind, SecretKey::Random(), StealthAddress::Random(), amount).GetRangeProof();
+}
+
+BOOST_AUTO_TEST_CASE(ProofDBTest)
+{
+    auto pDatabase = GetDB();
+
+    auto proof0 = CreateProof(1000);
+    auto proof1 = CreateProof(2000);
+    auto proof2 = CreateProof(3000);
+
+    ProofDB(pDatabase.get()).Add({
+        { mmr::LeafIndex::At(0), proof0 },
+        { mmr::LeafIndex::At(1), proof1 },
+        { mmr::LeafIndex::At(2), proof2 }
+    });
+
+    BOOST_REQUIRE(ProofDB(pDatabase.get()).Get(mmr::LeafIndex::At(0))->GetHash() == proof0->GetHash());
+    BOOST_REQUIRE(ProofDB(pDatabase.get()).Get(mmr::LeafIndex::At(1))->GetHash() == proof1->GetHash());
+    BOOST_REQUIRE(ProofDB(pDatabase.get()).Get(mmr::LeafIndex::At(2))->GetHash() == proof2->GetHash());
+    BOOST_REQUIRE(ProofDB(pDatabase.get()).Get(mmr::LeafIndex::At(3)) == nullptr);
+
+    // A reused leaf index is overwritten
+    auto proof1b = CreateProof(2500);
+    ProofDB(pDatabase.get()).Add({ { mmr::LeafIndex::At(1), proof1b } });
+    BOOST_REQUIRE(ProofDB(pDatabase.get()).Get(mmr::LeafIndex::At(1))->GetHash() == proof1b->GetHash());
+
+    // Pending writes are visible within the batch
+    {
+        auto pBatch = pDatabase->CreateBatch();
+        ProofDB batchDB(pDatabase.get(), pBatch.get());
+        batchDB.Add({ { mmr::LeafIndex::At(3), proof0 } });
+        BOOST_REQUIRE(batchDB.Get(mmr::LeafIndex::At(3)) != nullptr);
+    }
+    BOOST_REQUIRE(ProofDB(pDatabase.get()).Get(mmr::LeafIndex::At(3)) == nullptr);
+
+    ProofDB(pDatabase.get()).Remove({ mmr::LeafIndex::At(0) });
+    BOOST_REQUIRE(ProofDB(pDatabase.get()).Get(mmr::LeafIndex::At(0)) == nullptr);
+    BOOST_REQUIRE(ProofDB(pDatabase.get()).Get(mmr::LeafIndex::At(2)) != nullptr);
+
+    ProofDB(pDatabase.get()).RemoveAll();
+    BOOST_REQUIRE(ProofDB(pDatabase.get()).Get(mmr::LeafIndex::At(1)) == nullptr);
+    BOOST_REQUIRE(ProofDB(pDatabase.get()).Get(mmr::LeafIndex::At(2)) == nullptr);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
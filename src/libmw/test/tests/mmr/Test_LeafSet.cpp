@@ -58,4 +58,58 @@ BOOST_AUTO_TEST_CASE(LeafSetTest)
     }
 }
 
+BOOST_AUTO_TEST_CASE(LeafSetMultiChunkRoot)
+{
+    // Enough leaves to span several BLAKE3 chunks, with a partial final chunk.
+    const uint64_t num_leaves = 8 * 5000 + 3;
+    std::vector<uint8_t> expected((num_leaves + 7) / 8);
+    auto add = [&expected](ILeafSet& leafset, const uint64_t idx) {
+        leafset.Add(mmr::LeafIndex::At(idx));
+        expected[idx / 8] |= (0x80 >> (idx % 8));
+    };
+    auto remove = [&expected](ILeafSet& leafset, const uint64_t idx) {
+        leafset.Remove(mmr::LeafIndex::At(idx));
+        expected[idx / 8] &= ~(0x80 >> (idx % 8));
+    };
+
+    LeafSet::Ptr pLeafset = LeafSet::Open(GetDataDir(), 0);
+    for (uint64_t i = 0; i < num_leaves; i++) {
+        add(*pLeafset, i);
+    }
+    BOOST_REQUIRE(pLeafset->Root() == Hashed(expected));
+
+    remove(*pLeafset, 3);
+    remove(*pLeafset, 8 * 2048);
+    BOOST_REQUIRE(pLeafset->Root() == Hashed(expected));
+
+    pLeafset->Flush(1);
+    BOOST_REQUIRE(pLeafset->Root() == Hashed(expected));
+
+    // Cache layers only rehash the chunks they modify, and must track changes to the backing leafset.
+    auto pCache = std::make_shared<LeafSetCache>(pLeafset);
+    BOOST_REQUIRE(pCache->Root() == Hashed(expected));
+
+    remove(*pCache, 8 * 1024 + 5);
+    BOOST_REQUIRE(pCache->Root() == Hashed(expected));
+
+    remove(*pLeafset, 8 * 1030);
+    BOOST_REQUIRE(pCache->Root() == Hashed(expected));
+
+    LeafSetCache nested(pCache);
+    remove(nested, 8 * 4000);
+    add(nested, 3);
+    BOOST_REQUIRE(nested.Root() == Hashed(expected));
+
+    nested.Flush(2);
+    BOOST_REQUIRE(pCache->Root() == Hashed(expected));
+
+    pCache->Flush(2);
+    BOOST_REQUIRE(pLeafset->Root() == Hashed(expected));
+
+    // Rewinding to a shorter bitmap
+    pLeafset->Rewind(8 * 3000, {});
+    expected.resize(3000);
+    BOOST_REQUIRE(pLeafset->Root() == Hashed(expected));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
@@ -46,6 +46,11 @@ BOOST_AUTO_TEST_CASE(MMRTest)
     BOOST_REQUIRE(pmmr->GetNumNodes() == 8);
     BOOST_CHECK_EQUAL(pmmr->Root().ToHex(), "376ef1612abbb461ab78f317569c9a19d054f2c928c79410d50403564b91c5f7");
 
+    // Views read the same hashes without copying them
+    for (uint64_t pos = 0; pos < pmmr->GetNumNodes(); pos++) {
+        BOOST_REQUIRE(pmmr->GetHashView(Index::At(pos)) == pmmr->GetHash(Index::At(pos)));
+    }
+
     pmmr->Rewind(4);
     BOOST_REQUIRE(pmmr->GetNumLeaves() == 4);
     BOOST_REQUIRE(pmmr->GetNumNodes() == 7);
@@ -94,4 +99,148 @@ BOOST_AUTO_TEST_CASE(PMMRCacheTest)
     cache.Flush(1, nullptr);
 }
 
+BOOST_AUTO_TEST_CASE(PMMRIncrementalCommit)
+{
+    FilePath mmr_dir = GetDataDir() / "mmr";
+    PMMR::Ptr pmmr = PMMR::Open('O', mmr_dir, 0, GetDB(), nullptr);
+
+    std::vector<Leaf> leaves;
+    for (uint8_t i = 0; i < 5; i++) {
+        leaves.push_back(Leaf::Create(LeafIndex::At(i), { i, (uint8_t)(i + 1), (uint8_t)(i + 2) }));
+    }
+
+    // Appending hashes writes to the existing data file, rather than copying it.
+    pmmr->BatchWrite(1, LeafIndex::At(0), { leaves[0], leaves[1], leaves[2], leaves[3] }, nullptr);
+    pmmr->BatchWrite(2, LeafIndex::At(4), { leaves[4] }, nullptr);
+    BOOST_REQUIRE(!PMMR::GetPath(mmr_dir, 'O', 1).Exists());
+    BOOST_REQUIRE(!PMMR::GetPath(mmr_dir, 'O', 2).Exists());
+    BOOST_CHECK_EQUAL(pmmr->Root().ToHex(), "376ef1612abbb461ab78f317569c9a19d054f2c928c79410d50403564b91c5f7");
+
+    // Reopening an earlier file_index ignores hashes appended by later commits.
+    pmmr = PMMR::Open('O', mmr_dir, 1, GetDB(), nullptr);
+    BOOST_REQUIRE(pmmr->GetNumLeaves() == 4);
+    BOOST_CHECK_EQUAL(pmmr->Root().ToHex(), "9ab6e3c4a8594b9846b39b6beefe8f704c1de720f28426ddf3898bd4f8d6e45f");
+
+    // The data file is shared with file_index 2, so only the new hashes are written to a new one.
+    pmmr->BatchWrite(2, LeafIndex::At(4), { leaves[4] }, nullptr);
+    BOOST_REQUIRE(pmmr->GetNumLeaves() == 5);
+    BOOST_REQUIRE(File(PMMR::GetPath(mmr_dir, 'O', 2)).GetSize() == mw::Hash::size());
+
+    // Rewinding below committed hashes relocates only the hashes past the rewind point, leaving the old files intact.
+    pmmr->BatchWrite(3, LeafIndex::At(3), { leaves[3] }, nullptr);
+    BOOST_REQUIRE(File(PMMR::GetPath(mmr_dir, 'O', 3)).GetSize() == 3 * mw::Hash::size());
+    BOOST_REQUIRE(pmmr->GetNumLeaves() == 4);
+    BOOST_CHECK_EQUAL(pmmr->Root().ToHex(), "9ab6e3c4a8594b9846b39b6beefe8f704c1de720f28426ddf3898bd4f8d6e45f");
+
+    BOOST_REQUIRE(PMMR::Open('O', mmr_dir, 2, GetDB(), nullptr)->GetNumLeaves() == 5);
+
+    // The first data file still holds the prefix of file_index 3, but the one for file_index 2 is unused.
+    pmmr->Cleanup(3);
+    BOOST_REQUIRE(PMMR::GetPath(mmr_dir, 'O', 0).Exists());
+    BOOST_REQUIRE(!PMMR::GetPath(mmr_dir, 'O', 2).Exists());
+    BOOST_REQUIRE(!PMMR::GetManifestPath(mmr_dir, 'O', 2).Exists());
+    BOOST_REQUIRE(PMMR::GetManifestPath(mmr_dir, 'O', 3).Exists());
+
+    pmmr = PMMR::Open('O', mmr_dir, 3, GetDB(), nullptr);
+    BOOST_REQUIRE(pmmr->GetNumLeaves() == 4);
+    BOOST_CHECK_EQUAL(pmmr->Root().ToHex(), "9ab6e3c4a8594b9846b39b6beefe8f704c1de720f28426ddf3898bd4f8d6e45f");
+}
+
+BOOST_AUTO_TEST_CASE(PMMRReopenNewerIndex)
+{
+    FilePath mmr_dir = GetDataDir() / "reopen_mmr";
+    PMMR::Ptr pmmr = PMMR::Open('O', mmr_dir, 0, GetDB(), nullptr);
+
+    std::vector<Leaf> leaves;
+    for (uint8_t i = 0; i < 5; i++) {
+        leaves.push_back(Leaf::Create(LeafIndex::At(i), { i, (uint8_t)(i + 1), (uint8_t)(i + 2) }));
+    }
+    pmmr->BatchWrite(1, LeafIndex::At(0), { leaves[0], leaves[1], leaves[2], leaves[3] }, nullptr);
+    pmmr->BatchWrite(2, LeafIndex::At(4), { leaves[4] }, nullptr);
+    const size_t data_file_size = File(PMMR::GetPath(mmr_dir, 'O', 0)).GetSize();
+
+    // Opening the older file_index must leave the hashes committed for the newer one in place.
+    pmmr = PMMR::Open('O', mmr_dir, 1, GetDB(), nullptr);
+    BOOST_REQUIRE(pmmr->GetNumLeaves() == 4);
+    BOOST_REQUIRE(File(PMMR::GetPath(mmr_dir, 'O', 0)).GetSize() == data_file_size);
+
+    pmmr = PMMR::Open('O', mmr_dir, 2, GetDB(), nullptr);
+    BOOST_REQUIRE(pmmr->GetNumLeaves() == 5);
+    BOOST_CHECK_EQUAL(pmmr->Root().ToHex(), "376ef1612abbb461ab78f317569c9a19d054f2c928c79410d50403564b91c5f7");
+}
+
+BOOST_AUTO_TEST_CASE(PMMRLegacyHashFile)
+{
+    FilePath mmr_dir = GetDataDir() / "legacy_mmr";
+    PMMR::Ptr pmmr = PMMR::Open('O', mmr_dir, 0, GetDB(), nullptr);
+
+    std::vector<Leaf> leaves;
+    for (uint8_t i = 0; i < 5; i++) {
+        leaves.push_back(Leaf::Create(LeafIndex::At(i), { i, (uint8_t)(i + 1), (uint8_t)(i + 2) }));
+    }
+    pmmr->BatchWrite(1, LeafIndex::At(0), { leaves[0], leaves[1], leaves[2], leaves[3] }, nullptr);
+
+    // Strip the manifests, leaving a hash file that holds exactly the committed hashes.
+    PMMR::GetManifestPath(mmr_dir, 'O', 0).Remove();
+    PMMR::GetManifestPath(mmr_dir, 'O', 1).Remove();
+
+    // Opening it writes its manifest, so an append that's never committed is ignored on reopen.
+    pmmr = PMMR::Open('O', mmr_dir, 0, GetDB(), nullptr);
+    BOOST_REQUIRE(PMMR::GetManifestPath(mmr_dir, 'O', 0).Exists());
+    BOOST_REQUIRE(pmmr->GetNumLeaves() == 4);
+    pmmr->BatchWrite(1, LeafIndex::At(4), { leaves[4] }, nullptr);
+    BOOST_REQUIRE(pmmr->GetNumLeaves() == 5);
+
+    pmmr = PMMR::Open('O', mmr_dir, 0, GetDB(), nullptr);
+    BOOST_REQUIRE(pmmr->GetNumLeaves() == 4);
+    BOOST_CHECK_EQUAL(pmmr->Root().ToHex(), "9ab6e3c4a8594b9846b39b6beefe8f704c1de720f28426ddf3898bd4f8d6e45f");
+}
+
+BOOST_AUTO_TEST_CASE(AddLeavesBatch)
+{
+    // Leaf counts chosen to split across peaks of different heights, including on top of existing nodes.
+    const std::vector<size_t> batch_sizes{ 3, 1, 13, 0, 47 };
+
+    MemMMR expected;
+    MemMMR batched;
+    PMMRCache cache(std::make_shared<MemMMR>());
+    uint8_t i = 0;
+    for (size_t batch_size : batch_sizes) {
+        std::vector<Leaf> leaves;
+        for (size_t j = 0; j < batch_size; j++, i++) {
+            leaves.push_back(Leaf::Create(LeafIndex::At(i), { i, (uint8_t)(i + 1), (uint8_t)(i + 2) }));
+            expected.AddLeaf(leaves.back());
+        }
+
+        batched.AddLeaves(leaves);
+        cache.AddLeaves(leaves);
+
+        BOOST_REQUIRE(batched.GetNumLeaves() == expected.GetNumLeaves());
+        BOOST_REQUIRE(cache.GetNumLeaves() == expected.GetNumLeaves());
+        for (uint64_t pos = 0; pos < expected.GetNumNodes(); pos++) {
+            BOOST_REQUIRE(batched.GetHash(Index::At(pos)) == expected.GetHash(Index::At(pos)));
+            BOOST_REQUIRE(cache.GetHash(Index::At(pos)) == expected.GetHash(Index::At(pos)));
+        }
+
+        BOOST_REQUIRE(batched.Root() == expected.Root());
+        BOOST_REQUIRE(cache.Root() == expected.Root());
+    }
+
+    // Flushing writes all of the cached leaves to the PMMR in one append
+    PMMR::Ptr pmmr = PMMR::Open('O', GetDataDir() / "mmr", 0, GetDB(), nullptr);
+    PMMRCache pmmr_cache(pmmr);
+    pmmr_cache.AddLeaves(std::vector<Leaf>{ Leaf::Create(LeafIndex::At(0), { 0, 1, 2 }) });
+    pmmr_cache.Flush(1, nullptr);
+
+    std::vector<Leaf> leaves;
+    for (uint8_t j = 1; j < i; j++) {
+        leaves.push_back(Leaf::Create(LeafIndex::At(j), { j, (uint8_t)(j + 1), (uint8_t)(j + 2) }));
+    }
+
+    pmmr_cache.AddLeaves(leaves);
+    pmmr_cache.Flush(2, nullptr);
+    BOOST_REQUIRE(pmmr->GetNumLeaves() == expected.GetNumLeaves());
+    BOOST_REQUIRE(pmmr->Root() == expected.Root());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
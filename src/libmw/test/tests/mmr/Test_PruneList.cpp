@@ -24,4 +24,26 @@ BOOST_AUTO_TEST_CASE(PruneListTest)
     BOOST_REQUIRE(pPruneList->GetShift(mmr::Index::At(60)) == 15);
 }
 
+BOOST_AUTO_TEST_CASE(RankIndexedBitSetTest)
+{
+    // Span several superblocks, and end partway through a word.
+    BitSet bitset(5000 + 17);
+    for (size_t i = 0; i < bitset.size(); i++) {
+        if ((i * 7919) % 13 < 5 || (i >= 1024 && i < 1600)) {
+            bitset.set(i);
+        }
+    }
+
+    RankIndexedBitSet indexed(bitset);
+    BOOST_REQUIRE(indexed.size() == bitset.size());
+    BOOST_REQUIRE(indexed.count() == bitset.count());
+
+    for (size_t i = 0; i <= bitset.size() + 64; i++) {
+        BOOST_REQUIRE(indexed.test(i) == bitset.test(i));
+        BOOST_REQUIRE(indexed.rank(i) == bitset.rank(i));
+    }
+
+    BOOST_REQUIRE(RankIndexedBitSet().rank(10) == 0);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
@@ -42,6 +42,24 @@ BOOST_AUTO_TEST_CASE(TxUTXO)
         BOOST_REQUIRE(deserializer.Read<Output>() == output);
     }
 
+    //
+    // Compact Serialization
+    //
+    {
+        std::vector<uint8_t> serialized = CompactUTXO(std::make_shared<UTXO>(utxo)).Serialized();
+        BOOST_REQUIRE(serialized.size() + RangeProof::SIZE - mw::Hash::size() == utxo.Serialized().size());
+
+        UTXO::CPtr pCompact = CompactUTXO::Deserialize(serialized).GetUTXO();
+        BOOST_REQUIRE(pCompact->GetOutputID() == output.GetOutputID());
+        BOOST_REQUIRE(pCompact->GetBlockHeight() == blockHeight);
+        BOOST_REQUIRE(pCompact->GetLeafIndex() == leafIndex);
+        BOOST_REQUIRE(pCompact->GetRangeProofHash() == output.GetRangeProof()->GetHash());
+        BOOST_REQUIRE(!pCompact->HasRangeProof());
+        BOOST_CHECK_THROW(pCompact->GetOutput(), std::ios_base::failure);
+        BOOST_CHECK_THROW(pCompact->WithRangeProof(std::make_shared<RangeProof>()), std::invalid_argument);
+        BOOST_REQUIRE(pCompact->WithRangeProof(output.GetRangeProof()).GetOutput() == output);
+    }
+
     //
     // Getters
     //
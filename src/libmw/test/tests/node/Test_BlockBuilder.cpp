@@ -63,4 +63,28 @@ BOOST_AUTO_TEST_CASE(BlockBuilder)
     BOOST_CHECK(block_valid);
 }
 
+BOOST_AUTO_TEST_CASE(SkipsValidationOfValidatedTxs)
+{
+    auto db_view = CoinsViewDB::Open(GetDataDir(), nullptr, GetDB());
+    auto cached_view = std::make_shared<CoinsViewCache>(db_view);
+
+    // Same body as a valid pegin, but with a kernel offset that breaks the kernel sum.
+    test::Tx pegin_tx = test::Tx::CreatePegIn(150);
+    auto pInvalidTx = std::make_shared<mw::Transaction>(
+        BlindingFactor::Random(),
+        pegin_tx.GetTransaction()->GetStealthOffset(),
+        pegin_tx.GetTransaction()->GetBody()
+    );
+    BOOST_REQUIRE_THROW(pInvalidTx->Validate(), std::exception);
+
+    // An unvalidated tx is verified before it's added.
+    mw::BlockBuilder unvalidated_builder(150, cached_view);
+    BOOST_CHECK(!unvalidated_builder.AddTransaction(pInvalidTx, { pegin_tx.GetPegInCoin() }));
+    BOOST_CHECK(unvalidated_builder.AddTransaction(pegin_tx.GetTransaction(), { pegin_tx.GetPegInCoin() }));
+
+    // A tx that was already validated (e.g. by the mempool) is not verified again.
+    mw::BlockBuilder validated_builder(150, cached_view);
+    BOOST_CHECK(validated_builder.AddTransaction(pInvalidTx, { pegin_tx.GetPegInCoin() }, true));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
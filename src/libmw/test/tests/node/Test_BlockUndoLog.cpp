@@ -0,0 +1,159 @@
+// Copyright (c) 2021 The Litecoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <mw/node/BlockUndoLog.h>
+#include <mw/node/CoinsView.h>
+
+#include <test_framework/Miner.h>
+#include <test_framework/TestMWEB.h>
+
+BOOST_FIXTURE_TEST_SUITE(TestBlockUndoLog, MWEBTestingSetup)
+
+BOOST_AUTO_TEST_CASE(SnapshotRecentBlocks)
+{
+    auto pDatabase = GetDB();
+
+    auto pDBView = mw::CoinsViewDB::Open(GetDataDir(), nullptr, pDatabase);
+    BOOST_REQUIRE(pDBView != nullptr);
+
+    auto pCachedView = std::make_shared<mw::CoinsViewCache>(pDBView);
+
+    test::Miner miner(GetDataDir());
+    mw::BlockUndoLog undo_log(2);
+
+    ///////////////////////
+    // Mine Block 1
+    ///////////////////////
+    test::Tx block1_tx1 = test::Tx::CreatePegIn(1000);
+    auto block1 = miner.MineBlock(160, { block1_tx1 });
+    undo_log.Add(block1.GetBlock()->GetHeader()->GetHash(), pCachedView->ApplyBlock(block1.GetBlock()));
+
+    const auto& block1_tx1_output1 = block1_tx1.GetOutputs()[0];
+
+    // Flush, so the snapshots are built on top of the DB-backed leafset and PMMR
+    auto pBatch = pDatabase->CreateBatch();
+    pCachedView->Flush(pBatch);
+    pBatch->Commit();
+
+    ///////////////////////
+    // Mine Block 2
+    ///////////////////////
+    test::Tx block2_tx1 = test::Tx::CreatePegOut(block1_tx1_output1);
+    auto block2 = miner.MineBlock(161, { block2_tx1 });
+    undo_log.Add(block2.GetBlock()->GetHeader()->GetHash(), pCachedView->ApplyBlock(block2.GetBlock()));
+    BOOST_REQUIRE(pCachedView->GetUTXO(block1_tx1_output1.GetOutputID()) == nullptr);
+
+    ///////////////////////
+    // Mine Block 3
+    ///////////////////////
+    test::Tx block3_tx1 = test::Tx::CreatePegIn(1500);
+    auto block3 = miner.MineBlock(162, { block3_tx1 });
+    undo_log.Add(block3.GetBlock()->GetHeader()->GetHash(), pCachedView->ApplyBlock(block3.GetBlock()));
+
+    const auto& block3_tx1_output1 = block3_tx1.GetOutputs()[0];
+    const mw::Hash tip_leafset_root = pCachedView->GetLeafSet()->Root();
+
+    // Block 1's undo data was evicted, but blocks 2 and 3 are enough to reach back to block 1
+    BOOST_REQUIRE(undo_log.Size() == 2);
+
+    ///////////////////////
+    // Snapshot Block 1
+    ///////////////////////
+    auto header1 = block1.GetBlock()->GetHeader();
+    auto pSnapshot1 = undo_log.Snapshot(pCachedView, header1->GetHash());
+    BOOST_REQUIRE(pSnapshot1 != nullptr);
+    BOOST_REQUIRE(pSnapshot1->GetBestHeader()->GetHash() == header1->GetHash());
+    BOOST_REQUIRE(pSnapshot1->GetLeafSet()->Root() == header1->GetLeafsetRoot());
+    BOOST_REQUIRE(pSnapshot1->GetOutputPMMR()->Root() == header1->GetOutputRoot());
+    BOOST_REQUIRE(pSnapshot1->GetOutputPMMR()->GetNumLeaves() == header1->GetNumTXOs());
+    BOOST_REQUIRE(pSnapshot1->GetUTXO(block1_tx1_output1.GetOutputID()) != nullptr);
+    BOOST_REQUIRE(pSnapshot1->GetUTXO(block3_tx1_output1.GetOutputID()) == nullptr);
+
+    ///////////////////////
+    // Snapshot Tip
+    ///////////////////////
+    auto pSnapshot3 = undo_log.Snapshot(pCachedView, block3.GetBlock()->GetHeader()->GetHash());
+    BOOST_REQUIRE(pSnapshot3 != nullptr);
+    BOOST_REQUIRE(pSnapshot3->GetLeafSet()->Root() == tip_leafset_root);
+    BOOST_REQUIRE(pSnapshot3->GetUTXO(block3_tx1_output1.GetOutputID()) != nullptr);
+
+    // Building snapshots must leave the tip view untouched
+    BOOST_REQUIRE(pCachedView->GetBestHeader()->GetHash() == block3.GetBlock()->GetHeader()->GetHash());
+    BOOST_REQUIRE(pCachedView->GetLeafSet()->Root() == tip_leafset_root);
+    BOOST_REQUIRE(pCachedView->GetUTXO(block1_tx1_output1.GetOutputID()) == nullptr);
+
+    ///////////////////////
+    // Block Not Logged
+    ///////////////////////
+    undo_log.Clear();
+    BOOST_REQUIRE(undo_log.Snapshot(pCachedView, header1->GetHash()) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(SnapshotAfterRestart)
+{
+    auto pDatabase = GetDB();
+
+    auto pDBView = mw::CoinsViewDB::Open(GetDataDir(), nullptr, pDatabase);
+    BOOST_REQUIRE(pDBView != nullptr);
+
+    auto pCachedView = std::make_shared<mw::CoinsViewCache>(pDBView);
+
+    test::Miner miner(GetDataDir());
+
+    // Stands in for the undo files, which outlive the in-memory log.
+    std::map<mw::Hash, mw::BlockUndo::CPtr> undo_files;
+
+    test::Tx block1_tx1 = test::Tx::CreatePegIn(1000);
+    auto block1 = miner.MineBlock(160, { block1_tx1 });
+    undo_files[block1.GetBlock()->GetHeader()->GetHash()] = pCachedView->ApplyBlock(block1.GetBlock());
+
+    const auto& block1_tx1_output1 = block1_tx1.GetOutputs()[0];
+
+    test::Tx block2_tx1 = test::Tx::CreatePegOut(block1_tx1_output1);
+    auto block2 = miner.MineBlock(161, { block2_tx1 });
+    undo_files[block2.GetBlock()->GetHeader()->GetHash()] = pCachedView->ApplyBlock(block2.GetBlock());
+
+    test::Tx block3_tx1 = test::Tx::CreatePegIn(1500);
+    auto block3 = miner.MineBlock(162, { block3_tx1 });
+    undo_files[block3.GetBlock()->GetHeader()->GetHash()] = pCachedView->ApplyBlock(block3.GetBlock());
+
+    auto pBatch = pDatabase->CreateBatch();
+    pCachedView->Flush(pBatch);
+    pBatch->Commit();
+
+    // After a restart, the log is empty and the undo data has to be read back in.
+    size_t num_reads = 0;
+    auto read_undo = [&undo_files, &num_reads](const mw::Hash& header_hash) -> mw::BlockUndo::CPtr {
+        ++num_reads;
+        auto iter = undo_files.find(header_hash);
+        return iter != undo_files.end() ? iter->second : nullptr;
+    };
+
+    mw::BlockUndoLog undo_log(2);
+    auto header1 = block1.GetBlock()->GetHeader();
+    BOOST_REQUIRE(undo_log.Snapshot(pCachedView, header1->GetHash()) == nullptr);
+
+    auto pSnapshot1 = undo_log.Snapshot(pCachedView, header1->GetHash(), read_undo);
+    BOOST_REQUIRE(pSnapshot1 != nullptr);
+    BOOST_REQUIRE(num_reads == 2);
+    BOOST_REQUIRE(undo_log.Size() == 2);
+    BOOST_REQUIRE(pSnapshot1->GetBestHeader()->GetHash() == header1->GetHash());
+    BOOST_REQUIRE(pSnapshot1->GetLeafSet()->Root() == header1->GetLeafsetRoot());
+    BOOST_REQUIRE(pSnapshot1->GetOutputPMMR()->Root() == header1->GetOutputRoot());
+    BOOST_REQUIRE(pSnapshot1->GetUTXO(block1_tx1_output1.GetOutputID()) != nullptr);
+
+    // Requesting the same block again reuses the snapshot, without reading or undoing anything.
+    BOOST_REQUIRE(undo_log.Snapshot(pCachedView, header1->GetHash(), read_undo) == pSnapshot1);
+    BOOST_REQUIRE(num_reads == 2);
+
+    // The loaded undo data stays in the log.
+    auto header2 = block2.GetBlock()->GetHeader();
+    auto pSnapshot2 = undo_log.Snapshot(pCachedView, header2->GetHash());
+    BOOST_REQUIRE(pSnapshot2 != nullptr);
+    BOOST_REQUIRE(pSnapshot2 != pSnapshot1);
+    BOOST_REQUIRE(pSnapshot2->GetLeafSet()->Root() == header2->GetLeafsetRoot());
+    BOOST_REQUIRE(num_reads == 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
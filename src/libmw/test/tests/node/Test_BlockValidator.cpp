@@ -190,6 +190,66 @@ BOOST_AUTO_TEST_CASE(BlockValidator_Test_InvalidStealthExcess)
     BOOST_CHECK(!is_valid);
 }
 
+BOOST_AUTO_TEST_CASE(BlockValidator_Test_DeferredChecks)
+{
+    test::Miner miner(GetDataDir());
+
+    // The pegout spends an output from the previous block, so that the block's commitments don't cancel out.
+    test::Tx prev_tx = test::Tx::CreatePegIn(3'000'000);
+    mw::Block::CPtr pPrevBlock = miner.MineBlock(1, { prev_tx }).GetBlock();
+    const BlindingFactor& prev_kernel_offset = pPrevBlock->GetKernelOffset();
+
+    test::Tx pegin_tx = test::Tx::CreatePegIn(5'000'000);
+    test::Tx pegout_tx = test::Tx::CreatePegOut(prev_tx.GetOutputs().front());
+    mw::Block::CPtr pBlock = miner.MineBlock(2, { pegin_tx, pegout_tx }).GetBlock();
+
+    auto run_checks = [](const std::vector<BlockValidator::Check>& checks) {
+        return std::all_of(checks.begin(), checks.end(), [](const BlockValidator::Check& check) { return check(); });
+    };
+
+    // Signatures, rangeproofs, the stealth sum, and the kernel sum are all deferred
+    bool is_valid = BlockValidator::ValidateStructure(
+        pBlock,
+        std::vector<PegInCoin>{pegin_tx.GetPegInCoin()},
+        std::vector<PegOutCoin>{pegout_tx.GetPegOutCoin()}
+    );
+    BOOST_CHECK(is_valid);
+
+    std::vector<BlockValidator::Check> checks = BlockValidator::BuildChecks(pBlock, prev_kernel_offset, 4);
+    BOOST_CHECK(checks.size() == 4);
+    BOOST_CHECK(run_checks(checks));
+
+    // Kernel offset doesn't follow from the previous block's - only detected by the kernel sum check
+    checks = BlockValidator::BuildChecks(pBlock, BlindingFactor::Random(), 4);
+    BOOST_CHECK(checks.size() == 4);
+    BOOST_CHECK(checks[0]() && checks[1]() && checks[2]());
+    BOOST_CHECK(!checks[3]());
+
+    // Stealth excess invalid - only detected by the stealth sum check
+    mw::Block::CPtr pBlockStealthMismatch = std::make_shared<mw::Block>(
+        mw::MutHeader(pBlock->GetHeader())
+            .SetStealthOffset(SecretKey::Random().GetBigInt())
+            .Build(),
+        pBlock->GetTxBody()
+    );
+
+    is_valid = BlockValidator::ValidateStructure(
+        pBlockStealthMismatch,
+        std::vector<PegInCoin>{pegin_tx.GetPegInCoin()},
+        std::vector<PegOutCoin>{pegout_tx.GetPegOutCoin()}
+    );
+    BOOST_CHECK(is_valid);
+    BOOST_CHECK(!run_checks(BlockValidator::BuildChecks(pBlockStealthMismatch, prev_kernel_offset, 4)));
+
+    // Pegin mismatch - detected immediately
+    is_valid = BlockValidator::ValidateStructure(
+        pBlock,
+        std::vector<PegInCoin>{},
+        std::vector<PegOutCoin>{pegout_tx.GetPegOutCoin()}
+    );
+    BOOST_CHECK(!is_valid);
+}
+
 BOOST_AUTO_TEST_CASE(BlockValidator_Test_OutputSorting)
 {
     test::Miner miner(GetDataDir());
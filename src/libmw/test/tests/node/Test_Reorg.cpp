@@ -78,6 +78,11 @@ BOOST_AUTO_TEST_CASE(ReorgChain)
     BOOST_REQUIRE(pCachedView->GetUTXO(block2_tx1_output1.GetOutputID()) == nullptr);
     BOOST_REQUIRE(pDBView->GetUTXO(block3_tx1_output1.GetOutputID()) != nullptr);
     BOOST_REQUIRE(pCachedView->GetUTXO(block3_tx1_output1.GetOutputID()) != nullptr);
+
+    // Rangeproofs are stored apart from the coins, keyed by the leaf index that block 2's output used to have
+    BOOST_REQUIRE(!pDBView->GetUTXO(block3_tx1_output1.GetOutputID())->HasRangeProof());
+    auto pUTXO3 = pDBView->GetUTXOWithProof(block3_tx1_output1.GetOutputID());
+    BOOST_REQUIRE(pUTXO3->GetOutput() == block3_tx1_output1.GetOutput());
 }
 
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
@@ -79,8 +79,9 @@ bool Miner::AddMWEBTransaction(CTxMemPool::txiter iter)
 
     //
     // Add transaction to MWEB
+    // The transaction was validated by MWEB::Node::CheckTransaction when it was accepted to the mempool.
     //
-    if (!mweb_builder->AddTransaction(pTx->mweb_tx.m_transaction, pegins)) {
+    if (!mweb_builder->AddTransaction(pTx->mweb_tx.m_transaction, pegins, true)) {
         LogPrintf("Failed to add MWEB transaction\n");
         return false;
     }
@@ -123,7 +123,7 @@ bool Node::ContextualCheckBlock(const CBlock& block, const Consensus::Params& co
 
     // Verify that the mw::Block is valid, and the pegins and pegouts all match.
     if (!MWEB::Node::ValidateMWEBBlock(block)) {
-        return state.Invalid(BlockValidationResult::BLOCK_MUTATED, "bad-blk-mweb", "BlockValidator::ValidateBlock failed");
+        return state.Invalid(BlockValidationResult::BLOCK_MUTATED, "bad-blk-mweb", "BlockValidator::ValidateStructure failed");
     }
 
     return true;
@@ -155,9 +155,10 @@ bool Node::ValidateMWEBBlock(const CBlock& block)
         hogex_pegouts.push_back(PegOutCoin(out.nValue, {pubkey.begin(), pubkey.end()}));
     }
 
-    // Call into the libmw context-free block validator to validate the TxBody,
+    // Call into the libmw context-free block validator to validate the TxBody's structure,
     // and verify that the pegins and pegouts all match.
-    return BlockValidator::ValidateBlock(block.mweb_block.m_block, block_pegins, hogex_pegouts);
+    // The signature, rangeproof, stealth sum, and kernel sum checks are run by ConnectBlock on the script check threads.
+    return BlockValidator::ValidateStructure(block.mweb_block.m_block, block_pegins, hogex_pegouts);
 }
 
 bool Node::ConnectBlock(const CBlock& block, const Consensus::Params& consensus_params, const CBlockIndex* pindexPrev, CBlockUndo& blockundo, mw::CoinsViewCache& mweb_view, BlockValidationState& state)
@@ -212,7 +213,8 @@ bool Node::ConnectBlock(const CBlock& block, const Consensus::Params& consensus_
         }
 
         try {
-            blockundo.mwundo = mweb_view.ApplyBlock(block.mweb_block.m_block);
+            // The kernel sum is verified by the checks ConnectBlock queues from BlockValidator::BuildChecks.
+            blockundo.mwundo = mweb_view.ApplyBlock(block.mweb_block.m_block, false);
         } catch (const std::exception& e) {
             // MWEB: Need to distinguish between invalid blocks and mutated blocks
             return state.Invalid(BlockValidationResult::BLOCK_MUTATED, "mweb-connect-failed", strprintf("MWEB::Node::ConnectBlock(): Failed to connect MWEB block: %s", e.what()));
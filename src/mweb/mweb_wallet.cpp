@@ -1,10 +1,79 @@
 #include <mweb/mweb_wallet.h>
 #include <wallet/wallet.h>
 #include <wallet/coincontrol.h>
+#include <checkqueue.h>
 #include <util/bip32.h>
+#include <util/system.h>
+#include <util/threadnames.h>
+
+#include <boost/thread/thread.hpp>
 
 using namespace MWEB;
 
+// Batches smaller than this are not worth spreading across threads.
+static constexpr size_t MIN_OUTPUTS_PER_THREAD = 64;
+
+// Checks the view tag of a single output, keeping the shared secret (Ke*a) only if the view tag matches.
+class ViewTagCheck
+{
+public:
+    ViewTagCheck() = default;
+    ViewTagCheck(const mw::Keychain& keychain, const Output& output, boost::optional<PublicKey>& shared_secret)
+        : m_pKeychain(&keychain), m_pOutput(&output), m_pSharedSecret(&shared_secret) { }
+
+    bool operator()()
+    {
+        try {
+            PublicKey shared_secret;
+            if (m_pKeychain->CheckViewTag(*m_pOutput, shared_secret)) {
+                *m_pSharedSecret = std::move(shared_secret);
+            }
+        } catch (const std::exception& e) {
+            LogPrintf("Failed to check view tag of MWEB output %s: %s\n", m_pOutput->GetOutputID().ToHex(), e.what());
+            return false;
+        }
+
+        return true;
+    }
+
+    void swap(ViewTagCheck& check) noexcept
+    {
+        std::swap(m_pKeychain, check.m_pKeychain);
+        std::swap(m_pOutput, check.m_pOutput);
+        std::swap(m_pSharedSecret, check.m_pSharedSecret);
+    }
+
+private:
+    const mw::Keychain* m_pKeychain = nullptr;
+    const Output* m_pOutput = nullptr;
+    boost::optional<PublicKey>* m_pSharedSecret = nullptr;
+};
+
+static CCheckQueue<ViewTagCheck> scancheckqueue(128);
+static boost::thread_group g_scan_check_threads;
+static std::atomic<int> g_scan_check_workers{0};
+
+void MWEB::StartScanWorkerThreads(const int threads_num)
+{
+    assert(g_scan_check_workers == 0);
+    LogPrintf("MWEB wallet rescans use %d additional threads\n", threads_num);
+    for (int i = 0; i < threads_num; ++i) {
+        g_scan_check_threads.create_thread([i]() {
+            util::ThreadRename(strprintf("mwebscan.%i", i));
+            scancheckqueue.Thread();
+        });
+    }
+    g_scan_check_workers = threads_num;
+}
+
+void MWEB::StopScanWorkerThreads()
+{
+    // Any batch that is still running is finished by its calling thread.
+    g_scan_check_workers = 0;
+    g_scan_check_threads.interrupt_all();
+    g_scan_check_threads.join_all();
+}
+
 bool Wallet::UpgradeCoins()
 {
     mw::Keychain::Ptr keychain = GetKeychain();
@@ -53,6 +122,79 @@ std::vector<mw::Coin> Wallet::RewindOutputs(const CTransaction& tx)
     return coins;
 }
 
+std::vector<mw::Coin> Wallet::RewindOutputs(const std::vector<Output>& outputs)
+{
+    mw::Keychain::Ptr keychain = GetKeychain();
+
+    // Coins that are already fully rewound don't need to be scanned again.
+    std::vector<mw::Coin> coins;
+    std::vector<Output> to_rewind;
+    for (const Output& output : outputs) {
+        mw::Coin coin;
+        if (GetCoin(output.GetOutputID(), coin) && coin.IsMine()) {
+            if (coin.HasSpendKey() || !keychain || !keychain->HasSpendSecret()) {
+                coins.push_back(std::move(coin));
+                continue;
+            }
+        }
+
+        to_rewind.push_back(output);
+    }
+
+    if (!keychain || to_rewind.empty()) {
+        return coins;
+    }
+
+    std::vector<boost::optional<PublicKey>> shared_secrets(to_rewind.size());
+    std::vector<ViewTagCheck> checks;
+    checks.reserve(to_rewind.size());
+    for (size_t i = 0; i < to_rewind.size(); i++) {
+        checks.emplace_back(*keychain, to_rewind[i], shared_secrets[i]);
+    }
+
+    // Only the shared secret and view tag are computed for every output.
+    // Roughly 1 in 256 outputs that don't belong to the wallet will have a matching view tag,
+    // so the rest of the rewind only needs to run for the few outputs that pass this filter.
+    bool checked = false;
+    if (g_scan_check_workers > 0 && to_rewind.size() >= 2 * MIN_OUTPUTS_PER_THREAD) {
+        // The calling thread helps out until every check has run.
+        CCheckQueueControl<ViewTagCheck> control(&scancheckqueue);
+        std::vector<ViewTagCheck> queued = checks;
+        control.Add(queued);
+        checked = control.Wait();
+        if (!checked) {
+            m_pWallet->WalletLogPrintf("MWEB view tag checks failed, checking the batch of %u outputs on this thread\n", to_rewind.size());
+        }
+    }
+
+    if (!checked) {
+        // The queue stops at the first failed check, so every check is rerun here.
+        // Outputs whose view tag can't be checked are skipped.
+        for (ViewTagCheck& check : checks) {
+            check();
+        }
+    }
+
+    std::vector<mw::Coin> rewound;
+    for (size_t i = 0; i < to_rewind.size(); i++) {
+        mw::Coin coin;
+        if (shared_secrets[i] && keychain->RewindOutput(to_rewind[i], *shared_secrets[i], coin)) {
+            rewound.push_back(std::move(coin));
+        }
+    }
+
+    if (!rewound.empty()) {
+        WalletBatch batch(m_pWallet->GetDatabase());
+        for (const mw::Coin& coin : rewound) {
+            m_coins[coin.output_id] = coin;
+            batch.WriteMWEBCoin(coin);
+        }
+    }
+
+    coins.insert(coins.end(), rewound.begin(), rewound.end());
+    return coins;
+}
+
 bool Wallet::RewindOutput(const Output& output, mw::Coin& coin)
 {
     mw::Keychain::Ptr keychain = GetKeychain();
@@ -18,6 +18,14 @@ class CWallet;
 
 namespace MWEB {
 
+// Maximum number of threads, including the rescanning thread, that check view tags.
+static constexpr int MAX_SCAN_THREADS = 16;
+
+// Starts the worker threads that check view tags for Wallet::RewindOutputs.
+// Until they're started, and after they're stopped, each batch is checked on its calling thread.
+void StartScanWorkerThreads(const int threads_num);
+void StopScanWorkerThreads();
+
 class Wallet
 {
     CWallet* m_pWallet;
@@ -36,6 +44,10 @@ public:
     bool UpgradeCoins();
 
     std::vector<mw::Coin> RewindOutputs(const CTransaction& tx);
+
+    // Rewinds a batch of outputs, such as all of the outputs in a block. Used when rescanning the chain.
+    // The view tag checks are spread across the scan worker threads, if they've been started.
+    std::vector<mw::Coin> RewindOutputs(const std::vector<Output>& outputs);
     bool RewindOutput(const Output& output, mw::Coin& coin);
 
     bool GetStealthAddress(const mw::Coin& coin, StealthAddress& address) const;
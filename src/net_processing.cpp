@@ -32,7 +32,10 @@
 #include <util/system.h>
 #include <validation.h>
 
+#include <list>
+#include <map>
 #include <memory>
+#include <tuple>
 #include <typeinfo>
 
 /** Expiration time for orphan transactions in seconds */
@@ -103,10 +106,12 @@ static const unsigned int MAX_HEADERS_RESULTS = 2000;
 static const int MAX_CMPCTBLOCK_DEPTH = 5;
 /** Maximum depth of blocks we're willing to respond to GETBLOCKTXN requests for. */
 static const int MAX_BLOCKTXN_DEPTH = 10;
-/** Maximum depth of blocks we're willing to serve MWEB leafsets for. */
-static const int MAX_MWEB_LEAFSET_DEPTH = 10;
 /** Maximum number of MWEB UTXOs that can be requested in a batch. */
 static const uint16_t MAX_REQUESTED_MWEB_UTXOS = 4096;
+/** Maximum number of getmwebutxos requests a peer can have queued before it's disconnected. */
+static const size_t MAX_QUEUED_MWEB_UTXO_REQUESTS = 16;
+/** Maximum total size of the recently served mwebutxos responses we keep cached. */
+static const size_t MAX_MWEB_UTXOS_CACHE_BYTES = 16 << 20;
 /** Size of the "block download window": how far ahead of our current height do we fetch?
  *  Larger windows tolerate larger download speed differences between peer, but increase the potential
  *  degree of disordering of blocks on disk (which make reindexing and pruning harder). We'll probably
@@ -454,6 +459,21 @@ static CNodeState *State(NodeId pnode) EXCLUSIVE_LOCKS_REQUIRED(cs_main) {
     return &it->second;
 }
 
+struct GetMWEBUTXOsMsg
+{
+    GetMWEBUTXOsMsg() = default;
+
+    SERIALIZE_METHODS(GetMWEBUTXOsMsg, obj)
+    {
+        READWRITE(obj.block_hash, COMPACTSIZE(obj.start_index), obj.num_requested, obj.output_format);
+    }
+
+    uint256 block_hash;
+    uint64_t start_index;
+    uint16_t num_requested;
+    uint8_t output_format;
+};
+
 /**
  * Data structure for an individual peer. This struct is not protected by
  * cs_main since it does not contain validation-critical data.
@@ -483,6 +503,11 @@ struct Peer {
     /** Work queue of items requested by this peer **/
     std::deque<CInv> m_getdata_requests GUARDED_BY(m_getdata_requests_mutex);
 
+    /** Protects m_mweb_utxo_requests **/
+    Mutex m_mweb_utxo_requests_mutex;
+    /** Queue of getmwebutxos requests from this peer, answered one segment at a time **/
+    std::deque<GetMWEBUTXOsMsg> m_mweb_utxo_requests GUARDED_BY(m_mweb_utxo_requests_mutex);
+
     /** Number of addresses that can be processed from this peer. Start at 1 to
      *  permit self-announcement. */
     double m_addr_token_bucket{1.0};
@@ -1635,11 +1660,11 @@ void static ProcessGetBlockData(CNode& pfrom, const CChainParams& chainparams, c
         } else if (inv.IsMsgMWEBBlk()) {
             // Fast-path: in this case it is possible to serve the block directly from disk,
             // as the network format matches the format on disk
-            std::vector<uint8_t> block_data;
+            FlatFileView block_data;
             if (!ReadRawBlockFromDisk(block_data, pindex, chainparams.MessageStart())) {
                 assert(!"cannot load block from disk");
             }
-            connman.PushMessage(&pfrom, msgMaker.Make(NetMsgType::BLOCK, MakeSpan(block_data)));
+            connman.PushMessage(&pfrom, msgMaker.Make(NetMsgType::BLOCK, block_data.Data()));
             // Don't set pblock as we've sent the block
         } else {
             // Send block from disk
@@ -1733,6 +1758,27 @@ struct MWEBLeafsetMsg
     BitSet leafset;
 };
 
+/**
+ * Returns a view of the MWEB state as of the given block in the active chain.
+ * Recent blocks are rebuilt in memory from the chainstate's MWEB undo log. Otherwise,
+ * falls back to rewinding a temporary view of the chain tip, which requires reading blocks from disk.
+ */
+static mw::ICoinsView::Ptr GetMWEBViewAt(CChainState& chainstate, const CChainParams& chainparams, CBlockIndex* pindex) EXCLUSIVE_LOCKS_REQUIRED(cs_main)
+{
+    mw::ICoinsView::Ptr mweb_view = chainstate.GetMWEBSnapshot(pindex);
+    if (mweb_view) {
+        return mweb_view;
+    }
+
+    BlockValidationState state;
+    CCoinsViewCache temp_view(&chainstate.CoinsTip());
+    if (!ActivateArbitraryChain(state, temp_view, chainparams, pindex)) {
+        return nullptr;
+    }
+
+    return temp_view.GetMWEBView();
+}
+
 static void ProcessGetMWEBLeafset(CNode& pfrom, const ChainstateManager& chainman, const CChainParams& chainparams, const CInv& inv, CConnman& connman)
 {
     ActivateBestChainIfNeeded(chainparams, inv);
@@ -1774,57 +1820,83 @@ static void ProcessGetMWEBLeafset(CNode& pfrom, const ChainstateManager& chainma
     }
 
     // Rewind leafset to block height
-    BlockValidationState state;
-    CCoinsViewCache temp_view(&chainman.ActiveChainstate().CoinsTip());
-    if (!ActivateArbitraryChain(state, temp_view, chainparams, pindex)) {
+    mw::ICoinsView::Ptr mweb_view = GetMWEBViewAt(chainman.ActiveChainstate(), chainparams, pindex);
+    if (!mweb_view) {
         pfrom.fDisconnect = true;
         return;
     }
 
     // Serve leafset to peer
-    MWEBLeafsetMsg leafset_msg(pindex->GetBlockHash(), temp_view.GetMWEBCacheView()->GetLeafSet()->ToBitSet());
+    MWEBLeafsetMsg leafset_msg(pindex->GetBlockHash(), mweb_view->GetLeafSet()->ToBitSet());
     connman.PushMessage(&pfrom, CNetMsgMaker(pfrom.GetCommonVersion()).Make(NetMsgType::MWEBLEAFSET, leafset_msg));
 }
 
-struct GetMWEBUTXOsMsg
+/**
+ * Recently served mwebutxos responses, keyed by request and by the serialization
+ * version they were written with. Light clients syncing from the same block tend
+ * to request the same segments, so this saves rebuilding the rewound view and
+ * re-reading the UTXOs for each of them.
+ * Only consulted after the requested block was found in the active chain,
+ * and the MWEB state as of a given block hash never changes, so entries
+ * don't need to be invalidated on reorg.
+ */
+using MWEBUTXOsCacheKey = std::tuple<uint256, uint64_t, uint16_t, uint8_t, int>;
+struct MWEBUTXOsCacheEntry
 {
-    GetMWEBUTXOsMsg() = default;
+    MWEBUTXOsCacheKey key;
+    std::vector<unsigned char> payload;
+};
+static Mutex cs_mweb_utxos_cache;
+//! Most recently used first.
+static std::list<MWEBUTXOsCacheEntry> g_mweb_utxos_cache GUARDED_BY(cs_mweb_utxos_cache);
+static std::map<MWEBUTXOsCacheKey, std::list<MWEBUTXOsCacheEntry>::iterator> g_mweb_utxos_cache_index GUARDED_BY(cs_mweb_utxos_cache);
+static size_t g_mweb_utxos_cache_bytes GUARDED_BY(cs_mweb_utxos_cache) = 0;
 
-    SERIALIZE_METHODS(GetMWEBUTXOsMsg, obj)
-    {
-        READWRITE(obj.block_hash, COMPACTSIZE(obj.start_index), obj.num_requested, obj.output_format);
+static MWEBUTXOsCacheKey GetMWEBUTXOsCacheKey(const GetMWEBUTXOsMsg& get_utxos, const int version)
+{
+    return MWEBUTXOsCacheKey{get_utxos.block_hash, get_utxos.start_index, get_utxos.num_requested, get_utxos.output_format, version};
+}
+
+static bool GetCachedMWEBUTXOs(const GetMWEBUTXOsMsg& get_utxos, const int version, std::vector<unsigned char>& payload) LOCKS_EXCLUDED(cs_mweb_utxos_cache)
+{
+    LOCK(cs_mweb_utxos_cache);
+    auto it = g_mweb_utxos_cache_index.find(GetMWEBUTXOsCacheKey(get_utxos, version));
+    if (it == g_mweb_utxos_cache_index.end()) {
+        return false;
     }
 
-    uint256 block_hash;
-    uint64_t start_index;
-    uint16_t num_requested;
-    uint8_t output_format;
-};
+    payload = it->second->payload;
+    g_mweb_utxos_cache.splice(g_mweb_utxos_cache.begin(), g_mweb_utxos_cache, it->second);
+    return true;
+}
 
-struct MWEBUTXOsMsg
+static void CacheMWEBUTXOs(const GetMWEBUTXOsMsg& get_utxos, const int version, const std::vector<unsigned char>& payload) LOCKS_EXCLUDED(cs_mweb_utxos_cache)
 {
-    MWEBUTXOsMsg() = default;
+    if (payload.size() > MAX_MWEB_UTXOS_CACHE_BYTES / 4) return;
 
-    SERIALIZE_METHODS(MWEBUTXOsMsg, obj)
-    {
-        READWRITE(obj.block_hash, COMPACTSIZE(obj.start_index), obj.output_format, obj.utxos, obj.proof_hashes);
-    }
+    LOCK(cs_mweb_utxos_cache);
+    const MWEBUTXOsCacheKey key = GetMWEBUTXOsCacheKey(get_utxos, version);
+    if (g_mweb_utxos_cache_index.count(key)) return;
 
-    uint256 block_hash;
-    uint64_t start_index;
-    uint8_t output_format;
-    std::vector<NetUTXO> utxos;
-    std::vector<mw::Hash> proof_hashes;
-};
+    g_mweb_utxos_cache.push_front(MWEBUTXOsCacheEntry{key, payload});
+    g_mweb_utxos_cache_index.emplace(key, g_mweb_utxos_cache.begin());
+    g_mweb_utxos_cache_bytes += payload.size();
+    while (g_mweb_utxos_cache_bytes > MAX_MWEB_UTXOS_CACHE_BYTES) {
+        g_mweb_utxos_cache_bytes -= g_mweb_utxos_cache.back().payload.size();
+        g_mweb_utxos_cache_index.erase(g_mweb_utxos_cache.back().key);
+        g_mweb_utxos_cache.pop_back();
+    }
+}
 
-static void ProcessGetMWEBUTXOs(CNode& pfrom, const ChainstateManager& chainman, const CChainParams& chainparams, CConnman& connman, const GetMWEBUTXOsMsg& get_utxos)
+/** Checks the parts of a getmwebutxos request that don't depend on chain state, before it's queued. */
+static bool CheckGetMWEBUTXOs(CNode& pfrom, const GetMWEBUTXOsMsg& get_utxos)
 {
     if (get_utxos.num_requested > MAX_REQUESTED_MWEB_UTXOS) {
         LogPrint(BCLog::NET, "getmwebutxos num_requested %u > %u, disconnect peer=%d\n", get_utxos.num_requested, MAX_REQUESTED_MWEB_UTXOS, pfrom.GetId());
         if (!pfrom.HasPermission(PF_NOBAN)) {
             pfrom.fDisconnect = true;
         }
-        return;
+        return false;
     }
 
     static const std::set<uint8_t> supported_formats{
@@ -1836,9 +1908,23 @@ static void ProcessGetMWEBUTXOs(CNode& pfrom, const ChainstateManager& chainman,
         if (!pfrom.HasPermission(PF_NOBAN)) {
             pfrom.fDisconnect = true;
         }
-        return;
+        return false;
     }
 
+    return true;
+}
+
+/**
+ * Answers a single queued getmwebutxos request. The mwebutxos message
+ * (block_hash, start_index, output_format, utxos, proof_hashes) is written straight
+ * into the outgoing message buffer as each UTXO is read, rather than first being
+ * collected into an intermediate message.
+ */
+static void ProcessGetMWEBUTXOs(CNode& pfrom, const ChainstateManager& chainman, const CChainParams& chainparams, CConnman& connman, const GetMWEBUTXOsMsg& get_utxos) LOCKS_EXCLUDED(cs_main)
+{
+    CSerializedNetMsg msg;
+    msg.m_type = NetMsgType::MWEBUTXOS;
+
     LOCK(cs_main);
 
     if (chainman.ActiveChainstate().IsInitialBlockDownload()) {
@@ -1875,19 +1961,21 @@ static void ProcessGetMWEBUTXOs(CNode& pfrom, const ChainstateManager& chainman,
         return;
     }
 
+    if (GetCachedMWEBUTXOs(get_utxos, pfrom.GetCommonVersion(), msg.data)) {
+        connman.PushMessage(&pfrom, std::move(msg));
+        return;
+    }
+
     // Rewind leafset to block height
-    BlockValidationState state;
-    CCoinsViewCache temp_view(&chainman.ActiveChainstate().CoinsTip());
-    if (!ActivateArbitraryChain(state, temp_view, chainparams, pindex)) {
+    mw::ICoinsView::Ptr mweb_view = GetMWEBViewAt(chainman.ActiveChainstate(), chainparams, pindex);
+    if (!mweb_view) {
         pfrom.fDisconnect = true;
         return;
     }
 
-    auto mweb_cache = temp_view.GetMWEBCacheView();
-
     mmr::Segment segment = mmr::SegmentFactory::Assemble(
-        *mweb_cache->GetOutputPMMR(),
-        *mweb_cache->GetLeafSet(),
+        *mweb_view->GetOutputPMMR(),
+        *mweb_view->GetLeafSet(),
         mmr::LeafIndex::At(get_utxos.start_index),
         get_utxos.num_requested
     );
@@ -1897,32 +1985,33 @@ static void ProcessGetMWEBUTXOs(CNode& pfrom, const ChainstateManager& chainman,
         return;
     }
 
-    std::vector<NetUTXO> utxos;
-    utxos.reserve(segment.leaves.size());
+    CVectorWriter writer(SER_NETWORK, pfrom.GetCommonVersion(), msg.data, 0);
+    writer << get_utxos.block_hash << COMPACTSIZE(get_utxos.start_index) << get_utxos.output_format;
+    WriteCompactSize(writer, segment.leaves.size());
     for (const mmr::Leaf& leaf : segment.leaves) {
-        UTXO::CPtr utxo = mweb_cache->GetUTXO(leaf.vec());
+        // Rangeproofs are stored apart from the UTXOs, so they're only read when the full output was requested.
+        UTXO::CPtr utxo = get_utxos.output_format == NetUTXO::FULL_UTXO
+            ? mweb_view->GetUTXOWithProof(leaf.vec())
+            : mweb_view->GetUTXO(leaf.vec());
         if (!utxo) {
             LogPrint(BCLog::NET, "Could not build segment requested by getmwebutxos from peer=%d\n", pfrom.GetId());
             pfrom.fDisconnect = true;
             return;
         }
 
-        utxos.push_back(NetUTXO(get_utxos.output_format, utxo));
+        writer << NetUTXO(get_utxos.output_format, utxo);
     }
 
-    std::vector<mw::Hash> proof_hashes = segment.hashes;
+    WriteCompactSize(writer, segment.hashes.size() + (segment.lower_peak ? 1 : 0));
+    for (const mw::Hash& hash : segment.hashes) {
+        writer << hash;
+    }
     if (segment.lower_peak) {
-        proof_hashes.push_back(*segment.lower_peak);
+        writer << *segment.lower_peak;
     }
 
-    MWEBUTXOsMsg utxos_msg{
-        get_utxos.block_hash,
-        get_utxos.start_index,
-        get_utxos.output_format,
-        std::move(utxos),
-        std::move(proof_hashes)
-    };
-    connman.PushMessage(&pfrom, CNetMsgMaker(pfrom.GetCommonVersion()).Make(NetMsgType::MWEBUTXOS, utxos_msg));
+    CacheMWEBUTXOs(get_utxos, pfrom.GetCommonVersion(), msg.data);
+    connman.PushMessage(&pfrom, std::move(msg));
 }
 
 //! Determine whether or not a peer can request a transaction, and return it (or nullptr if not found or not allowed).
@@ -4123,7 +4212,23 @@ void PeerManager::ProcessMessage(CNode& pfrom, const std::string& msg_type, CDat
     if (msg_type == NetMsgType::GETMWEBUTXOS) {
         GetMWEBUTXOsMsg get_utxos;
         vRecv >> get_utxos;
-        ProcessGetMWEBUTXOs(pfrom, m_chainman, m_chainparams, m_connman, get_utxos);
+        if (!CheckGetMWEBUTXOs(pfrom, get_utxos)) {
+            return;
+        }
+
+        PeerRef peer = GetPeerRef(pfrom.GetId());
+        if (!peer) return;
+
+        LOCK(peer->m_mweb_utxo_requests_mutex);
+        if (peer->m_mweb_utxo_requests.size() >= MAX_QUEUED_MWEB_UTXO_REQUESTS) {
+            LogPrint(BCLog::NET, "getmwebutxos queue size %u >= %u, disconnect peer=%d\n", peer->m_mweb_utxo_requests.size(), MAX_QUEUED_MWEB_UTXO_REQUESTS, pfrom.GetId());
+            if (!pfrom.HasPermission(PF_NOBAN)) {
+                pfrom.fDisconnect = true;
+            }
+            return;
+        }
+
+        peer->m_mweb_utxo_requests.push_back(std::move(get_utxos));
         return;
     }
 
@@ -4195,6 +4300,16 @@ bool PeerManager::ProcessMessages(CNode* pfrom, std::atomic<bool>& interruptMsgP
         }
     }
 
+    // Answer at most one queued getmwebutxos per pass, so that a peer syncing
+    // the MWEB UTXO set can't hold up the message handler for other peers.
+    {
+        LOCK(peer->m_mweb_utxo_requests_mutex);
+        if (!peer->m_mweb_utxo_requests.empty() && !pfrom->fPauseSend) {
+            ProcessGetMWEBUTXOs(*pfrom, m_chainman, m_chainparams, m_connman, peer->m_mweb_utxo_requests.front());
+            peer->m_mweb_utxo_requests.pop_front();
+        }
+    }
+
     if (pfrom->fDisconnect)
         return false;
 
@@ -4205,6 +4320,11 @@ bool PeerManager::ProcessMessages(CNode* pfrom, std::atomic<bool>& interruptMsgP
         if (!peer->m_getdata_requests.empty()) return true;
     }
 
+    {
+        LOCK(peer->m_mweb_utxo_requests_mutex);
+        if (!peer->m_mweb_utxo_requests.empty()) return true;
+    }
+
     {
         LOCK(g_cs_orphans);
         if (!peer->m_orphan_work_set.empty()) return true;
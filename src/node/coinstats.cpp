@@ -7,6 +7,8 @@
 
 #include <coins.h>
 #include <hash.h>
+#include <mw/crypto/Pedersen.h>
+#include <mw/db/CoinDB.h>
 #include <serialize.h>
 #include <uint256.h>
 #include <util/system.h>
@@ -52,18 +54,84 @@ static void ApplyStats(CCoinsStats& stats, std::nullptr_t, const uint256& hash,
     }
 }
 
+//! Number of MWEB commitments summed at a time
+static constexpr size_t MWEB_COMMITMENT_BATCH_SIZE = 1000;
+
+static CHashWriter NewHash(const CHashWriter&)
+{
+    return CHashWriter(SER_GETHASH, PROTOCOL_VERSION);
+}
+static std::nullptr_t NewHash(std::nullptr_t) { return nullptr; }
+
+//! UTXOs are hashed in their compact form, which commits to the rangeproof by its hash, so the proofs needn't be read
+static void ApplyMWEBStats(CHashWriter& ss, const UTXO::CPtr& utxo)
+{
+    ss << CompactUTXO(utxo);
+}
+static void ApplyMWEBStats(std::nullptr_t, const UTXO::CPtr& utxo) {}
+
+//! Walk the MWEB UTXO set, summing the commitments in batches so memory stays bounded
+template <typename T>
+static bool GetMWEBStats(UTXOCursor& cursor, CCoinsStats& stats, T& hash_obj, const std::function<void()>& interruption_point)
+{
+    std::vector<Commitment> commitments{stats.mweb_total_commitment};
+    commitments.reserve(MWEB_COMMITMENT_BATCH_SIZE + 1);
+    while (cursor.Valid()) {
+        interruption_point();
+        UTXO::CPtr utxo = cursor.GetUTXO();
+        if (!utxo) {
+            return error("%s: unable to read MWEB UTXO", __func__);
+        }
+
+        ApplyMWEBStats(hash_obj, utxo);
+        stats.mweb_coins_count++;
+        commitments.push_back(utxo->GetCommitment());
+        if (commitments.size() > MWEB_COMMITMENT_BATCH_SIZE) {
+            commitments = {Pedersen::AddCommitments(commitments, {})};
+        }
+        cursor.Next();
+    }
+    stats.mweb_total_commitment = Pedersen::AddCommitments(commitments, {});
+    return true;
+}
+
 //! Calculate statistics about the unspent transaction output set
 template <typename T>
 static bool GetUTXOStats(CCoinsView* view, CCoinsStats& stats, T hash_obj, const std::function<void()>& interruption_point)
 {
     stats = CCoinsStats();
-    std::unique_ptr<CCoinsViewCursor> pcursor(view->Cursor());
-    assert(pcursor);
-
-    stats.hashBlock = pcursor->GetBestBlock();
+    std::unique_ptr<CCoinsViewCursor> pcursor;
+    std::unique_ptr<UTXOCursor> mweb_cursor;
     {
+        // Both cursors iterate over LevelDB snapshots taken when they're created.
+        // The chainstate is only written to while holding cs_main, so creating them
+        // under the lock guarantees they see the same block, and the (possibly long)
+        // walks below can run without it.
         LOCK(cs_main);
-        stats.nHeight = LookupBlockIndex(stats.hashBlock)->nHeight;
+        // The coin database has no best block until a coins cache write in progress is done.
+        for (CChainState* chainstate : g_chainman.GetAll()) {
+            if (view == &chainstate->CoinsDB() && !chainstate->WaitForCoinsFlush()) {
+                return false;
+            }
+        }
+        pcursor.reset(view->Cursor());
+        assert(pcursor);
+
+        stats.hashBlock = pcursor->GetBestBlock();
+        const CBlockIndex* pindex = LookupBlockIndex(stats.hashBlock);
+        if (!pindex) {
+            return false;
+        }
+        stats.nHeight = pindex->nHeight;
+
+        mw::ICoinsView::Ptr mweb_view = view->GetMWEBView();
+        if (pindex->mweb_header && mweb_view) {
+            stats.has_mweb = true;
+            stats.mweb_output_root = pindex->mweb_header->GetOutputRoot();
+            stats.mweb_leafset_root = pindex->mweb_header->GetLeafsetRoot();
+            stats.mweb_num_txos = pindex->mweb_header->GetNumTXOs();
+            mweb_cursor = CoinDB(mweb_view->GetDatabase().get()).NewCursor();
+        }
     }
 
     PrepareHash(hash_obj, stats);
@@ -93,6 +161,16 @@ static bool GetUTXOStats(CCoinsView* view, CCoinsStats& stats, T hash_obj, const
 
     FinalizeHash(hash_obj, stats);
 
+    if (mweb_cursor) {
+        // The MWEB UTXOs get their own hash, so hash_serialized_2 stays comparable with other nodes
+        T mweb_hash_obj = NewHash(hash_obj);
+        PrepareHash(mweb_hash_obj, stats);
+        if (!GetMWEBStats(*mweb_cursor, stats, mweb_hash_obj, interruption_point)) {
+            return false;
+        }
+        FinalizeMWEBHash(mweb_hash_obj, stats);
+    }
+
     stats.nDiskSize = view->EstimateSize();
     return true;
 }
@@ -123,3 +201,9 @@ static void FinalizeHash(CHashWriter& ss, CCoinsStats& stats)
     stats.hashSerialized = ss.GetHash();
 }
 static void FinalizeHash(std::nullptr_t, CCoinsStats& stats) {}
+
+static void FinalizeMWEBHash(CHashWriter& ss, CCoinsStats& stats)
+{
+    stats.mweb_hash_serialized = ss.GetHash();
+}
+static void FinalizeMWEBHash(std::nullptr_t, CCoinsStats& stats) {}
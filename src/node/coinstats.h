@@ -7,6 +7,8 @@
 #define BITCOIN_NODE_COINSTATS_H
 
 #include <amount.h>
+#include <mw/models/crypto/Commitment.h>
+#include <mw/models/crypto/Hash.h>
 #include <uint256.h>
 
 #include <cstdint>
@@ -32,6 +34,19 @@ struct CCoinsStats
 
     //! The number of coins contained.
     uint64_t coins_count{0};
+
+    //! Whether the best block has an MWEB header. The fields below are only set if it does.
+    bool has_mweb{false};
+    //! The number of unspent MWEB outputs.
+    uint64_t mweb_coins_count{0};
+    //! The sum of the commitments of all unspent MWEB outputs.
+    Commitment mweb_total_commitment{};
+    //! The hash of the serialized MWEB UTXOs (only set for HASH_SERIALIZED).
+    uint256 mweb_hash_serialized{};
+    //! The output PMMR root, leafset root and TXO count committed to by the best block's MWEB header.
+    mw::Hash mweb_output_root{};
+    mw::Hash mweb_leafset_root{};
+    uint64_t mweb_num_txos{0};
 };
 
 //! Calculate statistics about the unspent transaction output set
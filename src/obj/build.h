@@ -0,0 +1 @@
+#define BUILD_GIT_COMMIT "5ec6765-dirty"
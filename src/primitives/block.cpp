@@ -23,6 +23,21 @@ uint256 CBlockHeader::GetPoWHash() const
     return thash;
 }
 
+std::vector<uint256> GetPoWHashes(const std::vector<const CBlockHeader*>& headers)
+{
+    std::vector<uint256> hashes(headers.size());
+    std::vector<const char*> inputs;
+    std::vector<char*> outputs;
+    inputs.reserve(headers.size());
+    outputs.reserve(headers.size());
+    for (size_t i = 0; i < headers.size(); ++i) {
+        inputs.push_back(BEGIN(headers[i]->nVersion));
+        outputs.push_back(BEGIN(hashes[i]));
+    }
+    scrypt_1024_1_1_256_multi(inputs.data(), outputs.data(), headers.size());
+    return hashes;
+}
+
 std::string CBlock::ToString() const
 {
     std::stringstream s;
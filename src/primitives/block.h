@@ -61,6 +61,12 @@ public:
     }
 };
 
+/**
+ * Compute the scrypt proof-of-work hashes of several headers at once, using the
+ * multi-lane scrypt kernels when available. Equivalent to calling GetPoWHash() on each.
+ */
+std::vector<uint256> GetPoWHashes(const std::vector<const CBlockHeader*>& headers);
+
 
 class CBlock : public CBlockHeader
 {
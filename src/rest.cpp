@@ -6,6 +6,7 @@
 #include <chain.h>
 #include <chainparams.h>
 #include <core_io.h>
+#include <flatfile.h>
 #include <httpserver.h>
 #include <index/txindex.h>
 #include <node/context.h>
@@ -241,7 +242,12 @@ static bool rest_block(HTTPRequest* req,
     if (!ParseHashStr(hashStr, hash))
         return RESTERR(req, HTTP_BAD_REQUEST, "Invalid hash: " + hashStr);
 
+    // Blocks are stored on disk the way they're serialized here, unless RPC serialization
+    // strips their witness or MWEB data, so they can then be served without deserializing them.
+    const bool serve_raw = (rf == RetFormat::BINARY || rf == RetFormat::HEX) && RPCSerializationFlags() == 0;
+
     CBlock block;
+    FlatFileView raw_block;
     CBlockIndex* pblockindex = nullptr;
     CBlockIndex* tip = nullptr;
     {
@@ -255,24 +261,37 @@ static bool rest_block(HTTPRequest* req,
         if (IsBlockPruned(pblockindex))
             return RESTERR(req, HTTP_NOT_FOUND, hashStr + " not available (pruned data)");
 
-        if (!ReadBlockFromDisk(block, pblockindex, Params().GetConsensus()))
+        if (serve_raw) {
+            if (!ReadRawBlockFromDisk(raw_block, pblockindex, Params().MessageStart()))
+                return RESTERR(req, HTTP_NOT_FOUND, hashStr + " not found");
+        } else if (!ReadBlockFromDisk(block, pblockindex, Params().GetConsensus())) {
             return RESTERR(req, HTTP_NOT_FOUND, hashStr + " not found");
+        }
     }
 
     switch (rf) {
     case RetFormat::BINARY: {
+        req->WriteHeader("Content-Type", "application/octet-stream");
+        if (serve_raw) {
+            req->WriteReply(HTTP_OK, raw_block.Data());
+            return true;
+        }
         CDataStream ssBlock(SER_NETWORK, PROTOCOL_VERSION | RPCSerializationFlags());
         ssBlock << block;
         std::string binaryBlock = ssBlock.str();
-        req->WriteHeader("Content-Type", "application/octet-stream");
         req->WriteReply(HTTP_OK, binaryBlock);
         return true;
     }
 
     case RetFormat::HEX: {
-        CDataStream ssBlock(SER_NETWORK, PROTOCOL_VERSION | RPCSerializationFlags());
-        ssBlock << block;
-        std::string strHex = HexStr(ssBlock) + "\n";
+        std::string strHex;
+        if (serve_raw) {
+            strHex = HexStr(raw_block.Data()) + "\n";
+        } else {
+            CDataStream ssBlock(SER_NETWORK, PROTOCOL_VERSION | RPCSerializationFlags());
+            ssBlock << block;
+            strHex = HexStr(ssBlock) + "\n";
+        }
         req->WriteHeader("Content-Type", "text/plain");
         req->WriteReply(HTTP_OK, strHex);
         return true;
@@ -14,6 +14,8 @@
 #include <core_io.h>
 #include <hash.h>
 #include <index/blockfilterindex.h>
+#include <mw/crypto/Bulletproofs.h>
+#include <mw/crypto/Schnorr.h>
 #include <node/coinstats.h>
 #include <node/context.h>
 #include <node/utxo_snapshot.h>
@@ -1210,8 +1212,8 @@ static RPCHelpMan pruneblockchain()
 static RPCHelpMan gettxoutsetinfo()
 {
     return RPCHelpMan{"gettxoutsetinfo",
-                "\nReturns statistics about the unspent transaction output set.\n"
-                "Note this call may take some time.\n",
+                "\nReturns statistics about the unspent transaction output set, including the MWEB UTXOs.\n"
+                "Note this call may take some time. The UTXO set is read from a snapshot, so block processing isn't blocked meanwhile.\n",
                 {
                     {"hash_type", RPCArg::Type::STR, /* default */ "hash_serialized_2", "Which UTXO set hash should be calculated. Options: 'hash_serialized_2' (the legacy algorithm), 'none'."},
                 },
@@ -1226,6 +1228,15 @@ static RPCHelpMan gettxoutsetinfo()
                         {RPCResult::Type::STR_HEX, "hash_serialized_2", "The serialized hash (only present if 'hash_serialized_2' hash_type is chosen)"},
                         {RPCResult::Type::NUM, "disk_size", "The estimated size of the chainstate on disk"},
                         {RPCResult::Type::STR_AMOUNT, "total_amount", "The total amount"},
+                        {RPCResult::Type::OBJ, "mweb", /* optional */ true, "The MWEB UTXO set (only present once MWEB is active)",
+                        {
+                            {RPCResult::Type::NUM, "utxos", "The number of unspent MWEB outputs"},
+                            {RPCResult::Type::STR_HEX, "total_commitment", "The sum of the commitments of all unspent MWEB outputs"},
+                            {RPCResult::Type::STR_HEX, "hash_serialized", "The serialized hash of the MWEB UTXOs (only present if 'hash_serialized_2' hash_type is chosen)"},
+                            {RPCResult::Type::NUM, "num_txos", "The number of outputs ever added to the output PMMR, as committed to by the MWEB header"},
+                            {RPCResult::Type::STR_HEX, "output_root", "The output PMMR root committed to by the MWEB header"},
+                            {RPCResult::Type::STR_HEX, "leaf_root", "The leafset root committed to by the MWEB header"},
+                        }},
                     }},
                 RPCExamples{
                     HelpExampleCli("gettxoutsetinfo", "")
@@ -1253,6 +1264,18 @@ static RPCHelpMan gettxoutsetinfo()
         }
         ret.pushKV("disk_size", stats.nDiskSize);
         ret.pushKV("total_amount", ValueFromAmount(stats.nTotalAmount));
+        if (stats.has_mweb) {
+            UniValue mweb(UniValue::VOBJ);
+            mweb.pushKV("utxos", stats.mweb_coins_count);
+            mweb.pushKV("total_commitment", stats.mweb_total_commitment.ToHex());
+            if (hash_type == CoinStatsHashType::HASH_SERIALIZED) {
+                mweb.pushKV("hash_serialized", stats.mweb_hash_serialized.GetHex());
+            }
+            mweb.pushKV("num_txos", stats.mweb_num_txos);
+            mweb.pushKV("output_root", stats.mweb_output_root.ToHex());
+            mweb.pushKV("leaf_root", stats.mweb_leafset_root.ToHex());
+            ret.pushKV("mweb", mweb);
+        }
     } else {
         throw JSONRPCError(RPC_INTERNAL_ERROR, "Unable to read UTXO set");
     }
@@ -1673,6 +1696,15 @@ UniValue MempoolInfoToJSON(const CTxMemPool& pool)
     ret.pushKV("mempoolminfee", ValueFromAmount(std::max(pool.GetMinFee(maxmempool), ::minRelayTxFee).GetFeePerK()));
     ret.pushKV("minrelaytxfee", ValueFromAmount(::minRelayTxFee.GetFeePerK()));
     ret.pushKV("unbroadcastcount", uint64_t{pool.GetUnbroadcastTxs().size()});
+
+    const VerificationCache::Stats sig_stats = Schnorr::GetCacheStats();
+    const VerificationCache::Stats proof_stats = Bulletproofs::GetCacheStats();
+    UniValue mweb_cache(UniValue::VOBJ);
+    mweb_cache.pushKV("signature_hits", sig_stats.hits);
+    mweb_cache.pushKV("signature_misses", sig_stats.misses);
+    mweb_cache.pushKV("rangeproof_hits", proof_stats.hits);
+    mweb_cache.pushKV("rangeproof_misses", proof_stats.misses);
+    ret.pushKV("mwebsigcache", mweb_cache);
     return ret;
 }
 
@@ -1691,7 +1723,14 @@ static RPCHelpMan getmempoolinfo()
                         {RPCResult::Type::NUM, "maxmempool", "Maximum memory usage for the mempool"},
                         {RPCResult::Type::STR_AMOUNT, "mempoolminfee", "Minimum fee rate in " + CURRENCY_UNIT + "/kB for tx to be accepted. Is the maximum of minrelaytxfee and minimum mempool fee"},
                         {RPCResult::Type::STR_AMOUNT, "minrelaytxfee", "Current minimum relay fee for transactions"},
-                        {RPCResult::Type::NUM, "unbroadcastcount", "Current number of transactions that haven't passed initial broadcast yet"}
+                        {RPCResult::Type::NUM, "unbroadcastcount", "Current number of transactions that haven't passed initial broadcast yet"},
+                        {RPCResult::Type::OBJ, "mwebsigcache", "MWEB verification cache lookups since startup",
+                        {
+                            {RPCResult::Type::NUM, "signature_hits", "Number of MWEB signatures found in the cache"},
+                            {RPCResult::Type::NUM, "signature_misses", "Number of MWEB signatures that had to be verified"},
+                            {RPCResult::Type::NUM, "rangeproof_hits", "Number of MWEB rangeproofs found in the cache"},
+                            {RPCResult::Type::NUM, "rangeproof_misses", "Number of MWEB rangeproofs that had to be verified"},
+                        }},
                     }},
                 RPCExamples{
                     HelpExampleCli("getmempoolinfo", "")
@@ -1841,6 +1880,16 @@ static RPCHelpMan getchaintxstats()
                         {RPCResult::Type::NUM, "window_tx_count", "The number of transactions in the window. Only returned if \"window_block_count\" is > 0"},
                         {RPCResult::Type::NUM, "window_interval", "The elapsed time in the window in seconds. Only returned if \"window_block_count\" is > 0"},
                         {RPCResult::Type::NUM, "txrate", "The average rate of transactions per second in the window. Only returned if \"window_interval\" is > 0"},
+                        {RPCResult::Type::OBJ, "coinsprefetch", "Coins read ahead of connecting blocks since startup",
+                        {
+                            {RPCResult::Type::NUM, "threads", "Number of prefetch threads, 0 if disabled"},
+                            {RPCResult::Type::NUM, "blocks", "Number of blocks whose coins were prefetched"},
+                            {RPCResult::Type::NUM, "coins_read", "Number of coins looked up in the coin database"},
+                            {RPCResult::Type::NUM, "coins_warmed", "Number of coins added to the coins cache"},
+                            {RPCResult::Type::NUM, "coins_discarded", "Number of coins read that were outdated or already cached"},
+                            {RPCResult::Type::NUM, "input_hits", "Number of inputs of connected blocks found in the coins cache"},
+                            {RPCResult::Type::NUM, "input_misses", "Number of inputs of connected blocks that had to be read from the coin database"},
+                        }},
                     }},
                 RPCExamples{
                     HelpExampleCli("getchaintxstats", "")
@@ -1850,6 +1899,7 @@ static RPCHelpMan getchaintxstats()
 {
     const CBlockIndex* pindex;
     int blockcount = 30 * 24 * 60 * 60 / Params().GetConsensus().nPowTargetSpacing; // By default: 1 month
+    const CCoinsPrefetcher::Stats prefetch_stats = WITH_LOCK(cs_main, return ::ChainstateActive().CoinsPrefetcher().GetStats());
 
     if (request.params[1].isNull()) {
         LOCK(cs_main);
@@ -1896,6 +1946,16 @@ static RPCHelpMan getchaintxstats()
         }
     }
 
+    UniValue prefetch(UniValue::VOBJ);
+    prefetch.pushKV("threads", prefetch_stats.threads);
+    prefetch.pushKV("blocks", prefetch_stats.blocks);
+    prefetch.pushKV("coins_read", prefetch_stats.read);
+    prefetch.pushKV("coins_warmed", prefetch_stats.warmed);
+    prefetch.pushKV("coins_discarded", prefetch_stats.discarded);
+    prefetch.pushKV("input_hits", prefetch_stats.hits);
+    prefetch.pushKV("input_misses", prefetch_stats.misses);
+    ret.pushKV("coinsprefetch", prefetch);
+
     return ret;
 },
     };
@@ -2419,6 +2479,9 @@ static RPCHelpMan scantxoutset()
         {
             LOCK(cs_main);
             ::ChainstateActive().ForceFlushStateToDisk();
+            if (!::ChainstateActive().WaitForCoinsFlush()) {
+                throw JSONRPCError(RPC_INTERNAL_ERROR, "Unable to read UTXO set");
+            }
             pcursor = std::unique_ptr<CCoinsViewCursor>(::ChainstateActive().CoinsDB().Cursor());
             CHECK_NONFATAL(pcursor);
             tip = ::ChainActive().Tip();
@@ -2603,7 +2666,7 @@ static RPCHelpMan dumptxoutset()
 
         ::ChainstateActive().ForceFlushStateToDisk();
 
-        if (!GetUTXOStats(&::ChainstateActive().CoinsDB(), stats, CoinStatsHashType::NONE, node.rpc_interruption_point)) {
+        if (!::ChainstateActive().WaitForCoinsFlush() || !GetUTXOStats(&::ChainstateActive().CoinsDB(), stats, CoinStatsHashType::NONE, node.rpc_interruption_point)) {
             throw JSONRPCError(RPC_INTERNAL_ERROR, "Unable to read UTXO set");
         }
 
@@ -105,6 +105,9 @@ static RPCHelpMan getnetworkhashps()
     };
 }
 
+/** The maximum number of nonces to hash at once while generating blocks. */
+static const uint64_t MAX_POW_BATCH_SIZE = 16;
+
 static bool GenerateBlock(ChainstateManager& chainman, CBlock& block, uint64_t& max_tries, unsigned int& extra_nonce, uint256& block_hash)
 {
     block_hash.SetNull();
@@ -116,9 +119,30 @@ static bool GenerateBlock(ChainstateManager& chainman, CBlock& block, uint64_t&
 
     CChainParams chainparams(Params());
 
-    while (max_tries > 0 && block.nNonce < std::numeric_limits<uint32_t>::max() && !CheckProofOfWork(block.GetPoWHash(), block.nBits, chainparams.GetConsensus()) && !ShutdownRequested()) {
-        ++block.nNonce;
-        --max_tries;
+    // Hash consecutive nonces in batches, so the multi-lane scrypt kernels can be used.
+    // Batches start at a single nonce and grow while no solution is found, so easy
+    // targets (e.g. regtest) don't pay for hashing nonces past the first solution.
+    bool found = false;
+    uint64_t batch_size = 1;
+    std::vector<CBlockHeader> candidates;
+    std::vector<const CBlockHeader*> candidate_ptrs;
+    while (!found && max_tries > 0 && block.nNonce < std::numeric_limits<uint32_t>::max() && !ShutdownRequested()) {
+        const uint64_t count = std::min({batch_size, max_tries, uint64_t{std::numeric_limits<uint32_t>::max() - block.nNonce}});
+        candidates.assign(count, block.GetBlockHeader());
+        candidate_ptrs.clear();
+        for (uint64_t i = 0; i < count; ++i) {
+            candidates[i].nNonce = block.nNonce + i;
+            candidate_ptrs.push_back(&candidates[i]);
+        }
+
+        const std::vector<uint256> pow_hashes = GetPoWHashes(candidate_ptrs);
+        uint64_t tried = 0;
+        while (tried < count && !(found = CheckProofOfWork(pow_hashes[tried], block.nBits, chainparams.GetConsensus()))) {
+            ++tried;
+        }
+        block.nNonce += tried;
+        max_tries -= tried;
+        batch_size = std::min(batch_size * 2, MAX_POW_BATCH_SIZE);
     }
     if (max_tries == 0 || ShutdownRequested()) {
         return false;
@@ -194,6 +194,53 @@ public:
     }
 };
 
+/** Minimal stream for reading from an existing span of bytes, such as a memory mapped file
+ */
+class SpanReader
+{
+private:
+    const int m_type;
+    const int m_version;
+    Span<const unsigned char> m_data;
+
+public:
+
+    /**
+     * @param[in]  type Serialization Type
+     * @param[in]  version Serialization Version (including any flags)
+     * @param[in]  data Referenced bytes to read from
+     */
+    SpanReader(int type, int version, Span<const unsigned char> data)
+        : m_type(type), m_version(version), m_data(data) {}
+
+    template<typename T>
+    SpanReader& operator>>(T& obj)
+    {
+        // Unserialize from this stream
+        ::Unserialize(*this, obj);
+        return (*this);
+    }
+
+    int GetVersion() const { return m_version; }
+    int GetType() const { return m_type; }
+
+    size_t size() const { return m_data.size(); }
+    bool empty() const { return m_data.empty(); }
+
+    void read(char* dst, size_t n)
+    {
+        if (n == 0) {
+            return;
+        }
+
+        if (n > m_data.size()) {
+            throw std::ios_base::failure("SpanReader::read(): end of data");
+        }
+        memcpy(dst, m_data.data(), n);
+        m_data = m_data.subspan(n);
+    }
+};
+
 /** Double ended buffer combining vector and stream-like interfaces.
  *
  * >> and << read and write unformatted data using the above serialization templates.
@@ -815,6 +862,20 @@ public:
         return true;
     }
 
+    //! move the reading position anywhere in the source file, reading it again if it's no longer
+    //! buffered. Positions are relative to the position of the source file at construction.
+    bool Seek(uint64_t nPos) {
+        if (nPos <= nSrcPos && nPos + vchBuf.size() >= nSrcPos) {
+            nReadPos = nPos;
+            return true;
+        }
+        if (fseek(src, (long)((int64_t)nPos - (int64_t)nSrcPos), SEEK_CUR) != 0)
+            return false;
+        nSrcPos = nPos;
+        nReadPos = nPos;
+        return true;
+    }
+
     //! prevent reading beyond a certain position
     //! no argument removes the limit
     bool SetLimit(uint64_t nPos = std::numeric_limits<uint64_t>::max()) {
@@ -0,0 +1,275 @@
+// Copyright (c) 2021 The Litecoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BITCOIN_SUPPORT_ALLOCATORS_POOL_H
+#define BITCOIN_SUPPORT_ALLOCATORS_POOL_H
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <list>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/**
+ * A memory resource similar to std::pmr::unsynchronized_pool_resource, but
+ * optimized for node-based containers such as std::unordered_map.
+ *
+ * Memory is carved out of large chunks, and freed blocks are kept in
+ * per-size freelists instead of being returned to the system. Node-based
+ * containers allocate and free one node at a time, so nearly every
+ * allocation is served from a freelist or by bumping a pointer in the
+ * current chunk, and nodes end up densely packed next to each other, which
+ * greatly reduces malloc overhead and memory fragmentation.
+ *
+ * Allocations larger than MAX_BLOCK_SIZE_BYTES (such as the bucket array of
+ * a large unordered_map), or with a stricter alignment than ALIGN_BYTES, are
+ * passed through to ::operator new. Those may not be aligned more strictly
+ * than std::max_align_t.
+ *
+ * Memory held by the pool is only released when the resource is destroyed.
+ *
+ * @tparam MAX_BLOCK_SIZE_BYTES Largest allocation served by the pool.
+ * @tparam ALIGN_BYTES Required alignment of the pooled allocations.
+ */
+template <std::size_t MAX_BLOCK_SIZE_BYTES, std::size_t ALIGN_BYTES>
+class PoolResource final
+{
+    static_assert(ALIGN_BYTES > 0, "ALIGN_BYTES must be nonzero");
+    static_assert((ALIGN_BYTES & (ALIGN_BYTES - 1)) == 0, "ALIGN_BYTES must be a power of two");
+    static_assert(ALIGN_BYTES <= alignof(std::max_align_t), "Chunks are only aligned to std::max_align_t");
+
+    /**
+     * In-place linked list of the free blocks. Since the memory is unused,
+     * the list node is stored directly inside of it.
+     */
+    struct ListNode {
+        ListNode* m_next;
+
+        explicit ListNode(ListNode* next) : m_next(next) {}
+    };
+    static_assert(std::is_trivially_destructible<ListNode>::value, "Make sure we don't need to manually call a destructor");
+
+    //! Internal alignment value. Every allocation is a multiple of it, and it is large enough to hold a ListNode.
+    static constexpr std::size_t ELEM_ALIGN_BYTES = std::max(alignof(ListNode), ALIGN_BYTES);
+    static_assert((ELEM_ALIGN_BYTES & (ELEM_ALIGN_BYTES - 1)) == 0, "ELEM_ALIGN_BYTES must be a power of two");
+    static_assert(sizeof(ListNode) <= ELEM_ALIGN_BYTES, "Units of size ELEM_SIZE_ALIGN need to be able to store a ListNode");
+    static_assert((MAX_BLOCK_SIZE_BYTES & (ELEM_ALIGN_BYTES - 1)) == 0, "MAX_BLOCK_SIZE_BYTES needs to be a multiple of the alignment.");
+
+    //! Size in bytes of each allocated chunk.
+    const std::size_t m_chunk_size_bytes;
+
+    //! Chunks that were allocated so far, freed when the resource is destroyed.
+    std::list<char*> m_allocated_chunks{};
+
+    //! One freelist per block size, indexed by the number of ELEM_ALIGN_BYTES units the block spans.
+    std::array<ListNode*, MAX_BLOCK_SIZE_BYTES / ELEM_ALIGN_BYTES + 1> m_free_lists{};
+
+    //! Start and end of the not yet used memory in the current chunk.
+    char* m_available_memory_it = nullptr;
+    char* m_available_memory_end = nullptr;
+
+    //! Number of ELEM_ALIGN_BYTES units needed to store the given number of bytes. Zero sized allocations use one unit.
+    static constexpr std::size_t NumElemAlignBytes(std::size_t bytes)
+    {
+        return (bytes + ELEM_ALIGN_BYTES - 1) / ELEM_ALIGN_BYTES + (bytes == 0);
+    }
+
+    //! Whether an allocation can be served from the pool.
+    static constexpr bool IsFreeListUsable(std::size_t bytes, std::size_t alignment)
+    {
+        return alignment <= ELEM_ALIGN_BYTES && bytes <= MAX_BLOCK_SIZE_BYTES;
+    }
+
+    //! Constructs a ListNode in the given memory and prepends it to the freelist.
+    void PlacementAddToList(void* p, ListNode*& node)
+    {
+        node = new (p) ListNode{node};
+    }
+
+    /**
+     * Allocates a new chunk. Whatever is left over in the current chunk is
+     * always a multiple of ELEM_ALIGN_BYTES, so it is put into the matching
+     * freelist instead of being wasted.
+     */
+    void AllocateChunk()
+    {
+        const std::size_t remaining_available_bytes = m_available_memory_end - m_available_memory_it;
+        if (remaining_available_bytes != 0) {
+            PlacementAddToList(m_available_memory_it, m_free_lists[remaining_available_bytes / ELEM_ALIGN_BYTES]);
+        }
+
+        m_available_memory_it = static_cast<char*>(::operator new(m_chunk_size_bytes));
+        m_available_memory_end = m_available_memory_it + m_chunk_size_bytes;
+        m_allocated_chunks.emplace_back(m_available_memory_it);
+    }
+
+public:
+    /**
+     * Construct a new resource. The chunk size is rounded up to a multiple
+     * of the internal alignment, and must be at least MAX_BLOCK_SIZE_BYTES.
+     */
+    explicit PoolResource(std::size_t chunk_size_bytes)
+        : m_chunk_size_bytes(NumElemAlignBytes(chunk_size_bytes) * ELEM_ALIGN_BYTES)
+    {
+        assert(m_chunk_size_bytes >= MAX_BLOCK_SIZE_BYTES);
+        AllocateChunk();
+    }
+
+    //! Construct a new resource with the default chunk size of 256 KiB.
+    PoolResource() : PoolResource(262144) {}
+
+    PoolResource(const PoolResource&) = delete;
+    PoolResource& operator=(const PoolResource&) = delete;
+    PoolResource(PoolResource&&) = delete;
+    PoolResource& operator=(PoolResource&&) = delete;
+
+    ~PoolResource()
+    {
+        for (char* chunk : m_allocated_chunks) {
+            ::operator delete(chunk);
+        }
+    }
+
+    /**
+     * Allocates a block of the given size, taking it from the freelist if
+     * one is available, or else from the current chunk.
+     */
+    void* Allocate(std::size_t bytes, std::size_t alignment)
+    {
+        if (IsFreeListUsable(bytes, alignment)) {
+            const std::size_t num_alignments = NumElemAlignBytes(bytes);
+            if (m_free_lists[num_alignments] != nullptr) {
+                // Unlink the head of the freelist. ListNode is trivially destructible,
+                // so its memory can be handed out as is.
+                return std::exchange(m_free_lists[num_alignments], m_free_lists[num_alignments]->m_next);
+            }
+
+            const std::ptrdiff_t round_bytes = static_cast<std::ptrdiff_t>(num_alignments * ELEM_ALIGN_BYTES);
+            if (round_bytes > m_available_memory_end - m_available_memory_it) {
+                // Slow path, only taken when the current chunk is used up.
+                AllocateChunk();
+            }
+
+            // Always hand out the rounded up size, so the block fits its freelist once deallocated.
+            return std::exchange(m_available_memory_it, m_available_memory_it + round_bytes);
+        }
+
+        assert(alignment <= alignof(std::max_align_t));
+        return ::operator new(bytes);
+    }
+
+    /**
+     * Returns a block to its freelist, or to ::operator delete if it wasn't
+     * allocated from the pool.
+     */
+    void Deallocate(void* p, std::size_t bytes, std::size_t alignment) noexcept
+    {
+        if (IsFreeListUsable(bytes, alignment)) {
+            const std::size_t num_alignments = NumElemAlignBytes(bytes);
+            PlacementAddToList(p, m_free_lists[num_alignments]);
+        } else {
+            ::operator delete(p);
+        }
+    }
+
+    //! Number of chunks allocated so far.
+    std::size_t NumAllocatedChunks() const
+    {
+        return m_allocated_chunks.size();
+    }
+
+    //! Size in bytes of each chunk.
+    std::size_t ChunkSizeBytes() const
+    {
+        return m_chunk_size_bytes;
+    }
+
+    //! Number of free blocks in the freelist for blocks of the given size. Only meant for tests.
+    std::size_t NumFreeBlocks(std::size_t bytes) const
+    {
+        std::size_t num_blocks = 0;
+        for (const ListNode* node = m_free_lists[NumElemAlignBytes(bytes)]; node != nullptr; node = node->m_next) {
+            ++num_blocks;
+        }
+        return num_blocks;
+    }
+};
+
+
+/**
+ * Forwards all allocations and deallocations to a PoolResource, which has to
+ * outlive any container that uses the allocator.
+ */
+template <class T, std::size_t MAX_BLOCK_SIZE_BYTES, std::size_t ALIGN_BYTES = alignof(T)>
+class PoolAllocator
+{
+    PoolResource<MAX_BLOCK_SIZE_BYTES, ALIGN_BYTES>* m_resource;
+
+    template <typename U, std::size_t M, std::size_t A>
+    friend class PoolAllocator;
+
+public:
+    using value_type = T;
+    using ResourceType = PoolResource<MAX_BLOCK_SIZE_BYTES, ALIGN_BYTES>;
+
+    /**
+     * Not explicit so we can easily construct it with the correct resource.
+     */
+    PoolAllocator(ResourceType* resource) noexcept
+        : m_resource(resource)
+    {
+    }
+
+    PoolAllocator(const PoolAllocator& other) noexcept = default;
+    PoolAllocator& operator=(const PoolAllocator& other) noexcept = default;
+
+    template <class U>
+    PoolAllocator(const PoolAllocator<U, MAX_BLOCK_SIZE_BYTES, ALIGN_BYTES>& other) noexcept
+        : m_resource(other.resource())
+    {
+    }
+
+    /**
+     * The rebind struct here is mandatory because we use non type template arguments for
+     * PoolAllocator. See https://en.cppreference.com/w/cpp/named_req/Allocator#cite_note-2
+     */
+    template <typename U>
+    struct rebind {
+        using other = PoolAllocator<U, MAX_BLOCK_SIZE_BYTES, ALIGN_BYTES>;
+    };
+
+    T* allocate(std::size_t n)
+    {
+        return static_cast<T*>(m_resource->Allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept
+    {
+        m_resource->Deallocate(p, n * sizeof(T), alignof(T));
+    }
+
+    ResourceType* resource() const noexcept
+    {
+        return m_resource;
+    }
+};
+
+template <class T1, class T2, std::size_t MAX_BLOCK_SIZE_BYTES, std::size_t ALIGN_BYTES>
+bool operator==(const PoolAllocator<T1, MAX_BLOCK_SIZE_BYTES, ALIGN_BYTES>& a,
+                const PoolAllocator<T2, MAX_BLOCK_SIZE_BYTES, ALIGN_BYTES>& b) noexcept
+{
+    return a.resource() == b.resource();
+}
+
+template <class T1, class T2, std::size_t MAX_BLOCK_SIZE_BYTES, std::size_t ALIGN_BYTES>
+bool operator!=(const PoolAllocator<T1, MAX_BLOCK_SIZE_BYTES, ALIGN_BYTES>& a,
+                const PoolAllocator<T2, MAX_BLOCK_SIZE_BYTES, ALIGN_BYTES>& b) noexcept
+{
+    return !(a == b);
+}
+
+#endif // BITCOIN_SUPPORT_ALLOCATORS_POOL_H